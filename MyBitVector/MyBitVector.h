@@ -0,0 +1,365 @@
+#ifndef MY_BIT_VECTOR_H
+#define MY_BIT_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "../MyVector/MyVector.h"
+#include "../MyVectorView/VectorView.h"
+
+// Packed vector of flags, 64 per word. Bits past size() in the last word are
+// always kept at zero so the word level operations never need masking on
+// the way in.
+
+// Proxy standing in for a bool& to a single bit
+class MyBitReference {
+ public:
+  MyBitReference(std::uint64_t* word, std::uint64_t mask) : word_(word), mask_(mask) {}
+
+  operator bool() const { return (*word_ & mask_) != 0; }
+
+  MyBitReference& operator=(bool value) {
+    if (value) {
+      *word_ |= mask_;
+    } else {
+      *word_ &= ~mask_;
+    }
+    return *this;
+  }
+
+  MyBitReference& operator=(const MyBitReference &rhs) {
+    return *this = bool(rhs);
+  }
+
+  void flip() { *word_ ^= mask_; }
+
+ private:
+  std::uint64_t* word_;
+  std::uint64_t mask_;
+};
+
+// Bit Vector Iterator Definition
+class MyBitVectorIterator {
+ public:
+  MyBitVectorIterator(std::uint64_t* words, std::size_t pos) : words_(words), pos_(pos) {}
+
+  MyBitVectorIterator& operator++() {
+    pos_++;
+    return *this;
+  }
+
+  MyBitVectorIterator operator++(int) {
+    MyBitVectorIterator tmp = *this;
+    pos_++;
+    return tmp;
+  }
+
+  MyBitVectorIterator& operator--() {
+    pos_--;
+    return *this;
+  }
+
+  MyBitVectorIterator operator--(int) {
+    MyBitVectorIterator tmp = *this;
+    pos_--;
+    return tmp;
+  }
+
+  MyBitReference operator[](int index) const { return *(*this + index); }
+
+  MyBitReference operator*() const {
+    return MyBitReference(words_ + pos_ / 64, std::uint64_t(1) << (pos_ % 64));
+  }
+
+  bool operator==(const MyBitVectorIterator &rhs) const {
+    return words_ == rhs.words_ && pos_ == rhs.pos_;
+  }
+
+  bool operator!=(const MyBitVectorIterator &rhs) const {
+    return !(*this == rhs);
+  }
+
+  MyBitVectorIterator operator+(int i) const { return MyBitVectorIterator(words_, pos_ + i); }
+
+  MyBitVectorIterator operator-(int i) const { return MyBitVectorIterator(words_, pos_ - i); }
+
+  std::uint64_t* words_;
+  std::size_t pos_;
+};
+
+class MyBitVector {
+ public:
+  using ValueType = bool;
+  using ReferenceType = MyBitReference;
+  using WordType = std::uint64_t;
+  using Iterator = MyBitVectorIterator;
+
+  static constexpr std::size_t kWordBits = 64;
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+ public:
+  // Constructors:
+  MyBitVector() = default; // Default Constructor
+
+  MyBitVector(std::initializer_list<bool> elements) { // Using initializer list
+    reserve(elements.size());
+    for (bool x : elements) {
+      push_back(x);
+    }
+  }
+
+  MyBitVector(std::size_t n, bool value) { // Copies of specified element
+    resize(n, value);
+  }
+
+  // Builds a bit vector of size n (or just past the largest index when n is
+  // smaller) with the listed bits set
+  static MyBitVector from_indices(my::VectorView<const std::uint32_t> indices, std::size_t n = 0) {
+    for (std::size_t i {0}; i < indices.size(); i++) {
+      if (std::size_t(indices[i]) + 1 > n) {
+        n = std::size_t(indices[i]) + 1;
+      }
+    }
+    MyBitVector bits(n, false);
+    for (std::size_t i {0}; i < indices.size(); i++) {
+      bits.set(indices[i]);
+    }
+    return bits;
+  }
+
+  // Positions of the set bits in increasing order
+  MyVector<std::uint32_t> to_indices() const {
+    MyVector<std::uint32_t> indices;
+    indices.reserve(count());
+    for (std::size_t w {0}; w < words_.size(); w++) {
+      WordType word = words_[w];
+      while (word != 0) {
+        indices.push_back(static_cast<std::uint32_t>(w * kWordBits + __builtin_ctzll(word)));
+        word &= word - 1;
+      }
+    }
+    return indices;
+  }
+
+  // Element Access Methods
+  bool at(std::size_t pos) const { // Find element at index with bounds checking
+    if (pos >= size_) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    return test(pos);
+  }
+
+  bool test(std::size_t pos) const {
+    return (words_[pos / kWordBits] >> (pos % kWordBits)) & 1;
+  }
+
+  void set(std::size_t pos, bool value = true) {
+    (*this)[pos] = value;
+  }
+
+  void reset(std::size_t pos) {
+    words_[pos / kWordBits] &= ~(WordType(1) << (pos % kWordBits));
+  }
+
+  const WordType* data() const { return words_.data(); }
+
+  std::size_t word_count() const { return words_.size(); }
+
+  // Iterators
+  Iterator begin() {
+    return Iterator(words_.data(), 0);
+  }
+  Iterator end() {
+    return Iterator(words_.data(), size_);
+  }
+
+  // Capacity Methods
+  std::size_t size() const { return size_; }
+
+  std::size_t capacity() const { return words_.capacity() * kWordBits; }
+
+  bool empty() const { return size_ == 0; }
+
+  void reserve(std::size_t cap) {
+    words_.reserve(WordsFor(cap));
+  }
+
+  // Modifier Methods
+  void clear() {
+    words_.clear();
+    size_ = 0;
+  }
+
+  void push_back(bool value) {
+    if (size_ % kWordBits == 0) {
+      words_.push_back(0);
+    }
+    size_++;
+    set(size_ - 1, value);
+  }
+
+  void pop_back() {
+    size_--;
+    reset(size_);
+    if (size_ % kWordBits == 0) {
+      words_.pop_back();
+    }
+  }
+
+  void resize(std::size_t count, bool value = false) {
+    if (count < size_) {
+      while (words_.size() > WordsFor(count)) {
+        words_.pop_back();
+      }
+      size_ = count;
+      ClearTail();
+      return;
+    }
+    words_.reserve(WordsFor(count));
+    if (value && size_ % kWordBits != 0) {
+      words_[size_ / kWordBits] |= ~WordType(0) << (size_ % kWordBits);
+    }
+    while (words_.size() < WordsFor(count)) {
+      words_.push_back(value ? ~WordType(0) : 0);
+    }
+    size_ = count;
+    ClearTail();
+  }
+
+  // Flips every bit in place
+  MyBitVector& flip() {
+    for (std::size_t w {0}; w < words_.size(); w++) {
+      words_[w] = ~words_[w];
+    }
+    ClearTail();
+    return *this;
+  }
+
+  // Word Level Operations
+  std::size_t count() const { // Number of set bits
+    std::size_t total {0};
+    for (std::size_t w {0}; w < words_.size(); w++) {
+      total += __builtin_popcountll(words_[w]);
+    }
+    return total;
+  }
+
+  bool any() const {
+    for (std::size_t w {0}; w < words_.size(); w++) {
+      if (words_[w] != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool none() const { return !any(); }
+
+  std::size_t find_first() const { // Index of the first set bit, or npos
+    return FindFrom(0);
+  }
+
+  std::size_t find_next(std::size_t pos) const { // First set bit after pos, or npos
+    if (pos >= size_ || pos + 1 >= size_) { // pos + 1 wraps for npos
+      return npos;
+    }
+    return FindFrom(pos + 1);
+  }
+
+  // Operators
+  MyBitReference operator[](std::size_t i) {
+    return MyBitReference(&words_[i / kWordBits], WordType(1) << (i % kWordBits));
+  }
+
+  bool operator[](std::size_t i) const {
+    return test(i);
+  }
+
+  MyBitVector &operator&=(const MyBitVector &rhs) {
+    CheckSameSize(rhs);
+    for (std::size_t w {0}; w < words_.size(); w++) {
+      words_[w] &= rhs.words_[w];
+    }
+    return *this;
+  }
+
+  MyBitVector &operator|=(const MyBitVector &rhs) {
+    CheckSameSize(rhs);
+    for (std::size_t w {0}; w < words_.size(); w++) {
+      words_[w] |= rhs.words_[w];
+    }
+    return *this;
+  }
+
+  MyBitVector &operator^=(const MyBitVector &rhs) {
+    CheckSameSize(rhs);
+    for (std::size_t w {0}; w < words_.size(); w++) {
+      words_[w] ^= rhs.words_[w];
+    }
+    return *this;
+  }
+
+  MyBitVector operator~() const {
+    MyBitVector tmp(*this);
+    tmp.flip();
+    return tmp;
+  }
+
+  bool operator==(const MyBitVector &rhs) const {
+    if (size_ != rhs.size_) {
+      return false;
+    }
+    for (std::size_t w {0}; w < words_.size(); w++) {
+      if (words_[w] != rhs.words_[w]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator!=(const MyBitVector &rhs) const {
+    return !(*this == rhs);
+  }
+
+ private:
+  std::size_t size_ = 0; // Number of bits in vector
+  MyVector<WordType> words_;
+
+  static std::size_t WordsFor(std::size_t bits) {
+    return (bits + kWordBits - 1) / kWordBits;
+  }
+
+  // Zeroes the unused bits of the last word to keep the invariant
+  void ClearTail() {
+    if (size_ % kWordBits != 0) {
+      words_[words_.size() - 1] &= (WordType(1) << (size_ % kWordBits)) - 1;
+    }
+  }
+
+  std::size_t FindFrom(std::size_t pos) const {
+    std::size_t w = pos / kWordBits;
+    if (w >= words_.size()) {
+      return npos;
+    }
+    WordType word = words_[w] & (~WordType(0) << (pos % kWordBits));
+    while (true) {
+      if (word != 0) {
+        return w * kWordBits + __builtin_ctzll(word);
+      }
+      if (++w == words_.size()) {
+        return npos;
+      }
+      word = words_[w];
+    }
+  }
+
+  void CheckSameSize(const MyBitVector &rhs) const {
+    if (size_ != rhs.size_) {
+      throw std::invalid_argument("MyBitVector sizes differ");
+    }
+  }
+};
+
+#endif
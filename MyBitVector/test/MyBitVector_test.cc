@@ -0,0 +1,143 @@
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../MyBitVector.h"
+
+using std::vector;
+
+TEST(BitVectorConstructors, DefaultConstructor) {
+  MyBitVector bv;
+  EXPECT_EQ(bv.size(), 0);
+  EXPECT_TRUE(bv.empty());
+  EXPECT_EQ(bv.find_first(), MyBitVector::npos);
+}
+
+TEST(BitVectorConstructors, InitializerList) {
+  MyBitVector bv {true, false, true};
+  vector<bool> v {true, false, true};
+  ASSERT_EQ(bv.size(), v.size());
+  for (std::size_t i {0}; i < bv.size(); i++) {
+    EXPECT_EQ(bv[i], v[i]);
+  }
+}
+
+TEST(BitVectorConstructors, PackedStorage) {
+  MyBitVector bv (1000, true);
+  EXPECT_EQ(bv.word_count(), 16);
+  EXPECT_EQ(bv.count(), 1000);
+}
+
+// Fixture comparing a bit vector against std::vector<bool> across word boundaries
+struct BitVectorTest : testing::Test {
+  vector<bool> std_v;
+  MyBitVector my_v;
+
+  BitVectorTest() {
+    for (int i {0}; i < 150; i++) {
+      std_v.push_back(i % 3 == 0);
+      my_v.push_back(i % 3 == 0);
+    }
+  }
+
+  void VectorTest() {
+    ASSERT_EQ(std_v.size(), my_v.size());
+    for (std::size_t i {0}; i < my_v.size(); i++) {
+      EXPECT_EQ(std_v.at(i), my_v.at(i));
+    }
+  }
+};
+
+TEST_F(BitVectorTest, AtMethodOutOfRange) {
+  EXPECT_THROW(my_v.at(150), std::out_of_range);
+}
+
+TEST_F(BitVectorTest, ProxyReference) {
+  std_v[10] = true;
+  my_v[10] = true;
+  std_v[9] = false;
+  my_v[9] = false;
+  my_v[11] = my_v[10];
+  std_v[11] = std_v[10];
+  VectorTest();
+}
+
+TEST_F(BitVectorTest, PopBackMethod) {
+  for (int i {0}; i < 90; i++) {
+    std_v.pop_back();
+    my_v.pop_back();
+  }
+  VectorTest();
+  EXPECT_EQ(my_v.word_count(), 1);
+}
+
+TEST_F(BitVectorTest, ResizeGreaterThanSize) {
+  std_v.resize(300, true);
+  my_v.resize(300, true);
+  VectorTest();
+}
+
+TEST_F(BitVectorTest, ResizeLessThanSize) {
+  std_v.resize(70);
+  my_v.resize(70);
+  VectorTest();
+  EXPECT_EQ(my_v.count(), 24);
+}
+
+TEST_F(BitVectorTest, Iterators) {
+  std::size_t set {0};
+  for (auto it = my_v.begin(); it != my_v.end(); it++) {
+    set += bool(*it);
+  }
+  EXPECT_EQ(set, my_v.count());
+  EXPECT_EQ(set, 50);
+}
+
+TEST_F(BitVectorTest, FindFirstAndNext) {
+  std::size_t expected {0};
+  for (std::size_t pos = my_v.find_first(); pos != MyBitVector::npos; pos = my_v.find_next(pos)) {
+    EXPECT_EQ(pos, expected);
+    expected += 3;
+  }
+  EXPECT_EQ(expected, 150);
+}
+
+TEST(BitVectorFind, FindNextPastTheEnd) {
+  MyBitVector bv (100, false);
+  bv.set(3);
+  EXPECT_EQ(bv.find_next(MyBitVector::npos), MyBitVector::npos);
+  EXPECT_EQ(bv.find_next(bv.size() - 1), MyBitVector::npos);
+  EXPECT_EQ(bv.find_next(2), 3);
+}
+
+TEST_F(BitVectorTest, BulkOperators) {
+  MyBitVector other (150, false);
+  for (std::size_t i {0}; i < 150; i += 2) {
+    other.set(i);
+  }
+  MyBitVector a (my_v);
+  a &= other;
+  MyBitVector o (my_v);
+  o |= other;
+  MyBitVector x (my_v);
+  x ^= other;
+  for (std::size_t i {0}; i < 150; i++) {
+    EXPECT_EQ(a[i], my_v[i] && other[i]);
+    EXPECT_EQ(o[i], my_v[i] || other[i]);
+    EXPECT_EQ(x[i], my_v[i] != other[i]);
+  }
+  EXPECT_EQ((~my_v).count(), 100);
+  EXPECT_THROW(a &= MyBitVector(3, true), std::invalid_argument);
+}
+
+TEST(BitVectorIndices, RoundTrip) {
+  MyVector<std::uint32_t> indices {1, 64, 65, 200};
+  MyBitVector bv = MyBitVector::from_indices(indices);
+  EXPECT_EQ(bv.size(), 201);
+  EXPECT_EQ(bv.count(), 4);
+  MyVector<std::uint32_t> back = bv.to_indices();
+  ASSERT_EQ(back.size(), indices.size());
+  for (std::size_t i {0}; i < back.size(); i++) {
+    EXPECT_EQ(back[i], indices[i]);
+  }
+}
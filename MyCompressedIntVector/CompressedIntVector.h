@@ -0,0 +1,316 @@
+/*
+   Append only vector of 64 bit integers stored as bit packed blocks
+*/
+
+#ifndef MY_COMPRESSED_INT_VECTOR_H
+#define MY_COMPRESSED_INT_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "../MyVector/MyVector.h"
+
+namespace my {
+
+/* Values are grouped in blocks of 128. Every closed block is stored either
+   frame of reference (value - block minimum) or, for non decreasing blocks
+   where it is narrower, as deltas from the previous value. Either way the
+   block is bit packed at a fixed width, so 128 values take exactly 2 * bits
+   words and a block starts at a word offset recorded in its header. Delta
+   blocks are followed by a checkpoint every kCheckpointStride values (the
+   value minus the base, packed at the frame of reference width), so a
+   lookup sums at most kCheckpointStride - 1 deltas; a block only uses
+   deltas when they save space with the checkpoints counted. The last,
+   still open block is kept uncompressed until it fills up. */
+class CompressedIntVector {
+ public:
+  using ValueType = std::uint64_t;
+
+  static constexpr std::size_t kBlockSize = 128;
+  static constexpr std::size_t kCheckpointStride = 16;
+
+  /* Forward iterator that decodes a whole block at a time */
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::uint64_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::uint64_t*;
+    using reference = const std::uint64_t&;
+
+    Iterator(const CompressedIntVector* vec, std::size_t pos) : vec_(vec), pos_(pos) {
+      if (pos_ < vec_->size()) {
+        vec_->decode_block(pos_ / kBlockSize, buffer_);
+      }
+    }
+
+    const std::uint64_t& operator*() const { return buffer_[pos_ % kBlockSize]; }
+
+    Iterator& operator++() {
+      pos_++;
+      if (pos_ % kBlockSize == 0 && pos_ < vec_->size()) {
+        vec_->decode_block(pos_ / kBlockSize, buffer_);
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const Iterator &rhs) const { return pos_ == rhs.pos_; }
+    bool operator!=(const Iterator &rhs) const { return pos_ != rhs.pos_; }
+
+   private:
+    const CompressedIntVector* vec_;
+    std::size_t pos_;
+    std::uint64_t buffer_[kBlockSize];
+  };
+
+ public:
+  /* Constructors */
+
+  CompressedIntVector() {
+    words_.push_back(0);
+    words_.push_back(0);
+  }
+
+  CompressedIntVector(std::initializer_list<std::uint64_t> elements) : CompressedIntVector() {
+    for (std::uint64_t x : elements) {
+      push_back(x);
+    }
+  }
+
+  CompressedIntVector(const CompressedIntVector &) = default;
+  CompressedIntVector &operator=(const CompressedIntVector &) = default;
+
+  /* Leave rhs empty, padding words included */
+  CompressedIntVector(CompressedIntVector &&rhs)
+    : words_(std::move(rhs.words_)), blocks_(std::move(rhs.blocks_)), tail_size_(rhs.tail_size_) {
+    for (std::size_t j {0}; j < tail_size_; j++) {
+      tail_[j] = rhs.tail_[j];
+    }
+    rhs.clear(); // Puts back the padding words the move took
+  }
+
+  CompressedIntVector &operator=(CompressedIntVector &&rhs) {
+    if (this != &rhs) {
+      words_ = std::move(rhs.words_);
+      blocks_ = std::move(rhs.blocks_);
+      tail_size_ = rhs.tail_size_;
+      for (std::size_t j {0}; j < tail_size_; j++) {
+        tail_[j] = rhs.tail_[j];
+      }
+      rhs.clear(); // Puts back the padding words the move took
+    }
+    return *this;
+  }
+
+  /* Element access */
+
+  std::uint64_t operator[](std::size_t i) const {
+    std::size_t block = i / kBlockSize;
+    std::size_t j = i % kBlockSize;
+    if (block == blocks_.size()) {
+      return tail_[j];
+    }
+    const BlockHeader &h = blocks_[block];
+    const std::uint64_t* in = words_.data() + h.offset;
+    std::uint64_t mask = Mask(h.bits);
+    if (!h.delta) {
+      return h.base + Unpack(in, j, h.bits, mask);
+    }
+    std::size_t c = j / kCheckpointStride;
+    std::uint64_t value = h.base;
+    if (c > 0) {
+      value += Unpack(in + 2 * std::size_t(h.bits), c - 1, h.checkpoint_bits, Mask(h.checkpoint_bits));
+    }
+    for (std::size_t k {c * kCheckpointStride + 1}; k <= j; k++) {
+      value += Unpack(in, k, h.bits, mask);
+    }
+    return value;
+  }
+
+  std::uint64_t at(std::size_t i) const {
+    if (i >= size()) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    return (*this)[i];
+  }
+
+  /* Decodes all values of a block into out, which must hold kBlockSize
+     values. The unpack loop has no data dependent branches and every
+     iteration is independent, so it vectorizes; deltas are summed in a
+     second pass. */
+  void decode_block(std::size_t block, std::uint64_t* out) const {
+    if (block == blocks_.size()) {
+      for (std::size_t j {0}; j < tail_size_; j++) {
+        out[j] = tail_[j];
+      }
+      return;
+    }
+    const BlockHeader &h = blocks_[block];
+    const std::uint64_t* in = words_.data() + h.offset;
+    std::uint64_t mask = Mask(h.bits);
+    for (std::size_t j {0}; j < kBlockSize; j++) {
+      out[j] = Unpack(in, j, h.bits, mask);
+    }
+    if (h.delta) {
+      std::uint64_t value = h.base;
+      for (std::size_t j {0}; j < kBlockSize; j++) {
+        value += out[j];
+        out[j] = value;
+      }
+    } else {
+      for (std::size_t j {0}; j < kBlockSize; j++) {
+        out[j] += h.base;
+      }
+    }
+  }
+
+  /* Iterators */
+
+  Iterator begin() const { return Iterator(this, 0); }
+
+  Iterator end() const { return Iterator(this, size()); }
+
+  /* Capacity */
+
+  std::size_t size() const { return blocks_.size() * kBlockSize + tail_size_; }
+
+  bool empty() const { return size() == 0; }
+
+  std::size_t block_count() const { return blocks_.size() + (tail_size_ > 0 ? 1 : 0); }
+
+  /* Bytes held by the encoded data, headers and open tail block */
+  std::size_t memory_bytes() const {
+    return words_.capacity() * sizeof(std::uint64_t) +
+           blocks_.capacity() * sizeof(BlockHeader) + sizeof(tail_);
+  }
+
+  void reserve(std::size_t n) {
+    blocks_.reserve(n / kBlockSize);
+  }
+
+  /* Modifiers */
+
+  void push_back(std::uint64_t value) {
+    tail_[tail_size_++] = value;
+    if (tail_size_ == kBlockSize) {
+      EncodeTail();
+    }
+  }
+
+  void clear() {
+    words_.clear();
+    words_.push_back(0);
+    words_.push_back(0);
+    blocks_.clear();
+    tail_size_ = 0;
+  }
+
+ private:
+  struct BlockHeader {
+    std::uint64_t base = 0;   // Block minimum, or first value for delta blocks
+    std::uint64_t offset = 0; // First word of the packed block in words_
+    std::uint8_t bits = 0;    // Packed width of every value in the block
+    bool delta = false;       // Values are stored as deltas from the previous one
+    std::uint8_t checkpoint_bits = 0; // Packed width of the checkpoints of a delta block
+  };
+
+  /* Checkpoints at values kCheckpointStride, 2 * kCheckpointStride, ...;
+     value 0 needs none, it is the base */
+  static constexpr std::size_t kCheckpoints = kBlockSize / kCheckpointStride - 1;
+
+  static std::size_t CheckpointWords(unsigned bits) {
+    return (kCheckpoints * bits + 63) / 64;
+  }
+
+  static std::uint64_t Mask(unsigned bits) {
+    return bits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+  }
+
+  static unsigned Width(std::uint64_t x) {
+    return x == 0 ? 0 : 64 - __builtin_clzll(x);
+  }
+
+  /* Reads value j of a block packed at the given width. in[word + 1] is
+     always readable because words_ keeps two zero words past the last block
+     (enough even for a zero width block), and the double shift keeps the
+     spill term defined when shift is 0. */
+  static std::uint64_t Unpack(const std::uint64_t* in, std::size_t j, unsigned bits, std::uint64_t mask) {
+    std::size_t pos = j * bits;
+    std::size_t word = pos / 64;
+    unsigned shift = pos % 64;
+    std::uint64_t lo = in[word] >> shift;
+    std::uint64_t hi = (in[word + 1] << 1) << (63 - shift);
+    return (lo | hi) & mask;
+  }
+
+  /* Ors x, which fits in bits, into slot j of zeroed packed words */
+  static void Pack(std::uint64_t* out, std::size_t j, unsigned bits, std::uint64_t x) {
+    std::size_t pos = j * bits;
+    std::size_t word = pos / 64;
+    unsigned shift = pos % 64;
+    out[word] |= x << shift;
+    if (shift + bits > 64) {
+      out[word + 1] |= x >> (64 - shift);
+    }
+  }
+
+  void EncodeTail() {
+    std::uint64_t min = tail_[0];
+    std::uint64_t max = tail_[0];
+    std::uint64_t max_delta = 0;
+    bool sorted = true;
+    for (std::size_t j {1}; j < kBlockSize; j++) {
+      min = tail_[j] < min ? tail_[j] : min;
+      max = tail_[j] > max ? tail_[j] : max;
+      if (tail_[j] < tail_[j - 1]) {
+        sorted = false;
+      } else if (tail_[j] - tail_[j - 1] > max_delta) {
+        max_delta = tail_[j] - tail_[j - 1];
+      }
+    }
+
+    BlockHeader h;
+    unsigned for_bits = Width(max - min);
+    unsigned delta_bits = Width(max_delta);
+    h.delta = sorted && 2 * delta_bits + CheckpointWords(for_bits) < 2 * for_bits;
+    h.bits = h.delta ? delta_bits : for_bits;
+    h.checkpoint_bits = h.delta ? for_bits : 0;
+    h.base = h.delta ? tail_[0] : min;
+
+    // The new block starts over the padding, which is pushed out behind it.
+    h.offset = words_.size() - 2;
+    std::size_t words = 2 * std::size_t(h.bits) + CheckpointWords(h.checkpoint_bits);
+    for (std::size_t w {0}; w < words; w++) {
+      words_.push_back(0);
+    }
+    std::uint64_t* out = words_.data() + h.offset;
+    for (std::size_t j {0}; j < kBlockSize && h.bits > 0; j++) {
+      Pack(out, j, h.bits, h.delta ? (j == 0 ? 0 : tail_[j] - tail_[j - 1]) : tail_[j] - min);
+    }
+    for (std::size_t c {0}; c < kCheckpoints && h.delta; c++) {
+      Pack(out + 2 * std::size_t(h.bits), c, h.checkpoint_bits, tail_[(c + 1) * kCheckpointStride] - h.base);
+    }
+
+    blocks_.push_back(h);
+    tail_size_ = 0;
+  }
+
+  MyVector<std::uint64_t> words_; // Packed blocks followed by two zero words
+  MyVector<BlockHeader> blocks_;
+  std::uint64_t tail_[kBlockSize];
+  std::size_t tail_size_ = 0;
+};
+
+} // Namespace bracket
+
+#endif
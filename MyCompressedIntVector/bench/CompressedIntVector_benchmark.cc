@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <random>
+#include <benchmark/benchmark.h>
+#include "../CompressedIntVector.h"
+
+// Sequential decode throughput of CompressedIntVector against a plain
+// MyVector<uint64_t> holding the same posting list like data: sorted values
+// with small random gaps. Bytes processed count the decoded 8 byte values,
+// so the GB/s figures are directly comparable. The compression ratio is
+// reported as a counter on the CompressedIntVector runs.
+
+static const std::size_t kElements = 1 << 24;
+
+static void Fill(std::size_t n, std::uint64_t max_gap, MyVector<std::uint64_t> &plain, my::CompressedIntVector &packed) {
+  std::mt19937_64 rng(42);
+  std::uint64_t value {1600000000000};
+  plain.reserve(n);
+  for (std::size_t i {0}; i < n; i++) {
+    value += rng() % max_gap;
+    plain.push_back(value);
+    packed.push_back(value);
+  }
+}
+
+static void BM_MyVectorScan(benchmark::State &state) {
+  MyVector<std::uint64_t> plain;
+  my::CompressedIntVector packed;
+  Fill(kElements, state.range(0), plain, packed);
+  for (auto _ : state) {
+    std::uint64_t sum {0};
+    for (std::size_t i {0}; i < plain.size(); i++) {
+      sum += plain[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * kElements * sizeof(std::uint64_t));
+}
+
+static void BM_CompressedIteratorScan(benchmark::State &state) {
+  MyVector<std::uint64_t> plain;
+  my::CompressedIntVector packed;
+  Fill(kElements, state.range(0), plain, packed);
+  for (auto _ : state) {
+    std::uint64_t sum {0};
+    for (auto it = packed.begin(); it != packed.end(); ++it) {
+      sum += *it;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * kElements * sizeof(std::uint64_t));
+  state.counters["ratio"] = double(plain.capacity() * sizeof(std::uint64_t)) / packed.memory_bytes();
+}
+
+static void BM_CompressedBlockDecode(benchmark::State &state) {
+  MyVector<std::uint64_t> plain;
+  my::CompressedIntVector packed;
+  Fill(kElements, state.range(0), plain, packed);
+  std::uint64_t buffer[my::CompressedIntVector::kBlockSize];
+  for (auto _ : state) {
+    for (std::size_t b {0}; b < packed.block_count(); b++) {
+      packed.decode_block(b, buffer);
+      benchmark::DoNotOptimize(buffer);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * kElements * sizeof(std::uint64_t));
+  state.counters["ratio"] = double(plain.capacity() * sizeof(std::uint64_t)) / packed.memory_bytes();
+}
+
+static void BM_CompressedRandomAccess(benchmark::State &state) {
+  MyVector<std::uint64_t> plain;
+  my::CompressedIntVector packed;
+  Fill(kElements, state.range(0), plain, packed);
+  std::mt19937_64 rng(7);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(packed[rng() % kElements]);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Argument is the largest gap between consecutive values
+BENCHMARK(BM_MyVectorScan)->Arg(16)->Arg(1 << 12)->Arg(1 << 20);
+BENCHMARK(BM_CompressedIteratorScan)->Arg(16)->Arg(1 << 12)->Arg(1 << 20);
+BENCHMARK(BM_CompressedBlockDecode)->Arg(16)->Arg(1 << 12)->Arg(1 << 20);
+BENCHMARK(BM_CompressedRandomAccess)->Arg(16)->Arg(1 << 12)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
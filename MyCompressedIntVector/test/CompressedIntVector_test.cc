@@ -0,0 +1,136 @@
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../CompressedIntVector.h"
+
+using my::CompressedIntVector;
+
+// Fixture filling a CompressedIntVector and a std::vector with the same data
+struct CompressedIntVectorTest : testing::Test {
+  std::vector<std::uint64_t> std_v;
+  CompressedIntVector my_v;
+
+  void Append(std::uint64_t x) {
+    std_v.push_back(x);
+    my_v.push_back(x);
+  }
+
+  void VectorTest() {
+    ASSERT_EQ(std_v.size(), my_v.size());
+    for (std::size_t i {0}; i < std_v.size(); i++) {
+      EXPECT_EQ(std_v[i], my_v[i]) << "index " << i;
+    }
+    std::size_t i {0};
+    for (auto it = my_v.begin(); it != my_v.end(); it++) {
+      EXPECT_EQ(std_v[i], *it) << "iterator index " << i;
+      i++;
+    }
+    EXPECT_EQ(i, std_v.size());
+  }
+};
+
+TEST_F(CompressedIntVectorTest, EmptyVector) {
+  EXPECT_TRUE(my_v.empty());
+  EXPECT_EQ(my_v.begin(), my_v.end());
+  EXPECT_THROW(my_v.at(0), std::out_of_range);
+}
+
+TEST_F(CompressedIntVectorTest, OpenTailBlockOnly) {
+  for (std::uint64_t i {0}; i < 50; i++) {
+    Append(i * 7);
+  }
+  VectorTest();
+}
+
+TEST_F(CompressedIntVectorTest, SortedUsesDeltas) {
+  std::uint64_t value {1000000000000};
+  for (int i {0}; i < 1000; i++) {
+    value += i % 5;
+    Append(value);
+  }
+  VectorTest();
+  // 7 closed blocks at 3 bits per value plus headers, far below 8 bytes each
+  EXPECT_LT(my_v.memory_bytes(), std_v.size() * sizeof(std::uint64_t) / 2);
+}
+
+TEST_F(CompressedIntVectorTest, UnsortedUsesFrameOfReference) {
+  std::mt19937_64 rng(1);
+  for (int i {0}; i < 700; i++) {
+    Append(5000000 + rng() % 4096);
+  }
+  VectorTest();
+}
+
+TEST_F(CompressedIntVectorTest, ConstantAndFullWidthBlocks) {
+  for (int i {0}; i < 128; i++) {
+    Append(42);
+  }
+  std::mt19937_64 rng(2);
+  for (int i {0}; i < 300; i++) {
+    Append(rng());
+  }
+  VectorTest();
+}
+
+TEST_F(CompressedIntVectorTest, DecodeBlock) {
+  for (std::uint64_t i {0}; i < 256; i++) {
+    Append(i * i);
+  }
+  std::uint64_t out[CompressedIntVector::kBlockSize];
+  my_v.decode_block(1, out);
+  for (std::size_t j {0}; j < CompressedIntVector::kBlockSize; j++) {
+    EXPECT_EQ(out[j], std_v[128 + j]);
+  }
+}
+
+TEST_F(CompressedIntVectorTest, ClearMethod) {
+  for (std::uint64_t i {0}; i < 300; i++) {
+    Append(i);
+  }
+  my_v.clear();
+  std_v.clear();
+  Append(9);
+  VectorTest();
+}
+
+TEST_F(CompressedIntVectorTest, DeltaRandomAccessAcrossCheckpoints) {
+  std::mt19937_64 rng(3);
+  std::uint64_t value {1 << 20};
+  for (int i {0}; i < 1000; i++) {
+    value += rng() % 8;
+    Append(value);
+  }
+  for (int k {0}; k < 5000; k++) {
+    std::size_t i = rng() % std_v.size();
+    EXPECT_EQ(my_v[i], std_v[i]) << "index " << i;
+  }
+  VectorTest();
+}
+
+TEST_F(CompressedIntVectorTest, MovedFromVectorIsReusable) {
+  for (std::uint64_t i {0}; i < 300; i++) {
+    Append(i * 3);
+  }
+  CompressedIntVector moved (std::move(my_v));
+  for (std::size_t i {0}; i < std_v.size(); i++) {
+    EXPECT_EQ(moved[i], std_v[i]);
+  }
+  EXPECT_TRUE(my_v.empty());
+  std_v.clear();
+  for (std::uint64_t i {0}; i < 300; i++) { // Closes blocks in the moved from vector
+    Append(i * 5);
+  }
+  VectorTest();
+
+  CompressedIntVector assigned;
+  assigned = std::move(my_v);
+  EXPECT_EQ(assigned[299], 299 * 5);
+  EXPECT_TRUE(my_v.empty());
+  std_v.clear();
+  for (std::uint64_t i {0}; i < 200; i++) {
+    Append(i);
+  }
+  VectorTest();
+}
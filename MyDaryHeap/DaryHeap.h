@@ -0,0 +1,395 @@
+/*
+   d-ary heap priority queues backed by MyVector
+*/
+
+#ifndef MY_DARY_HEAP_H
+#define MY_DARY_HEAP_H
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "../MyVector/MyVector.h"
+
+namespace my {
+
+namespace detail {
+
+/* Sift helpers shared by both heaps. They work on a hole: the value being
+   placed is held aside while the elements it passes move into the hole, so
+   every step is one move instead of a swap. placed(i) is called for every
+   element that lands at index i, which lets the indexed heap keep its
+   position map current. */
+
+template <std::size_t D, typename E, typename Less, typename Placed>
+void SiftUp(E* heap, std::size_t i, Less less, Placed placed) {
+  E value = std::move(heap[i]);
+  while (i > 0) {
+    std::size_t parent = (i - 1) / D;
+    if (!less(heap[parent], value)) {
+      break;
+    }
+    heap[i] = std::move(heap[parent]);
+    placed(i);
+    i = parent;
+  }
+  heap[i] = std::move(value);
+  placed(i);
+}
+
+template <std::size_t D, typename E, typename Less, typename Placed>
+void SiftDown(E* heap, std::size_t n, std::size_t i, Less less, Placed placed) {
+  E value = std::move(heap[i]);
+  while (true) {
+    std::size_t first = D * i + 1;
+    if (first >= n) {
+      break;
+    }
+    std::size_t last = first + D < n ? first + D : n;
+    std::size_t best = first;
+    for (std::size_t c {first + 1}; c < last; c++) {
+      best = less(heap[best], heap[c]) ? c : best;
+    }
+    if (!less(value, heap[best])) {
+      break;
+    }
+    heap[i] = std::move(heap[best]);
+    placed(i);
+    i = best;
+  }
+  heap[i] = std::move(value);
+  placed(i);
+}
+
+/* Removes heap[0]: the hole at the root follows the best child all the way
+   down to a leaf, without comparing against the value that will fill it,
+   and the last element is then sifted up from there. The last element
+   almost always belongs near the bottom, so this saves the comparison per
+   level that SiftDown would spend on it. */
+template <std::size_t D, typename E, typename Less, typename Placed>
+void PopRoot(E* heap, std::size_t n, Less less, Placed placed) {
+  std::size_t last = n - 1;
+  std::size_t i {0};
+  while (true) {
+    std::size_t first = D * i + 1;
+    if (first >= last) {
+      break;
+    }
+    std::size_t end = first + D < last ? first + D : last;
+    std::size_t best = first;
+    for (std::size_t c {first + 1}; c < end; c++) {
+      best = less(heap[best], heap[c]) ? c : best;
+    }
+    heap[i] = std::move(heap[best]);
+    placed(i);
+    i = best;
+  }
+  if (i != last) {
+    heap[i] = std::move(heap[last]);
+    SiftUp<D>(heap, i, less, placed);
+  }
+}
+
+/* Floyd's bottom up construction, O(n) */
+template <std::size_t D, typename E, typename Less, typename Placed>
+void MakeHeap(E* heap, std::size_t n, Less less, Placed placed) {
+  for (std::size_t i {n > 1 ? (n - 2) / D + 1 : 0}; i-- > 0;) {
+    SiftDown<D>(heap, n, i, less, placed);
+  }
+}
+
+struct NoPlaced {
+  void operator()(std::size_t) const {}
+};
+
+} // namespace detail
+
+/* Priority queue with D children per node. Like std::priority_queue, top()
+   is the largest element under Compare, so pass std::greater for a min
+   heap. A wider node makes the tree log2(D) times shallower and keeps all
+   children of a node next to each other, so with D = 4 or 8 and small
+   elements a sift down reads one cache line per level. */
+template <typename T, std::size_t D = 4, typename Compare = std::less<T>>
+class DaryHeap {
+  static_assert(D >= 2, "A heap node needs at least two children");
+
+ public:
+  using ValueType = T;
+  using ReferenceType = const T&;
+
+ public:
+  DaryHeap() = default;
+
+  explicit DaryHeap(const Compare &comp) : comp_(comp) {}
+
+  /* Takes over the elements of values and heapifies them in place, O(n) */
+  explicit DaryHeap(MyVector<T> &&values, const Compare &comp = Compare())
+    : heap_(std::move(values)), comp_(comp) {
+    detail::MakeHeap<D>(heap_.data(), heap_.size(), comp_, detail::NoPlaced());
+  }
+
+  /* Element access */
+
+  const T& top() const {
+    if (heap_.size() == 0) {
+      throw std::out_of_range("top() on an empty DaryHeap");
+    }
+    return heap_[std::size_t(0)];
+  }
+
+  /* Capacity */
+
+  std::size_t size() const { return heap_.size(); }
+
+  bool empty() const { return heap_.size() == 0; }
+
+  void reserve(std::size_t cap) { heap_.reserve(cap); }
+
+  /* Modifiers */
+
+  void push(const T &value) {
+    heap_.push_back(value);
+    detail::SiftUp<D>(heap_.data(), heap_.size() - 1, comp_, detail::NoPlaced());
+  }
+
+  void push(T &&value) {
+    heap_.push_back(std::move(value));
+    detail::SiftUp<D>(heap_.data(), heap_.size() - 1, comp_, detail::NoPlaced());
+  }
+
+  template <typename ...Args>
+  void emplace(Args&& ...args) {
+    push(T(std::forward<Args>(args)...));
+  }
+
+  /* Appends [first, last). A batch at least as large as the heap is cheaper
+     to absorb with one O(n) rebuild than with a sift up per element. */
+  template <typename InputIt>
+  void push_range(InputIt first, InputIt last) {
+    std::size_t old_size = heap_.size();
+    for (; first != last; ++first) {
+      heap_.push_back(*first);
+    }
+    std::size_t added = heap_.size() - old_size;
+    if (added >= old_size) {
+      detail::MakeHeap<D>(heap_.data(), heap_.size(), comp_, detail::NoPlaced());
+      return;
+    }
+    for (std::size_t i {old_size}; i < heap_.size(); i++) {
+      detail::SiftUp<D>(heap_.data(), i, comp_, detail::NoPlaced());
+    }
+  }
+
+  void pop() {
+    if (heap_.size() == 0) {
+      throw std::out_of_range("pop() on an empty DaryHeap");
+    }
+    detail::PopRoot<D>(heap_.data(), heap_.size(), comp_, detail::NoPlaced());
+    heap_.pop_back();
+  }
+
+  /* Removes the top n elements (or all of them, if fewer) and returns them
+     in pop order */
+  MyVector<T> pop_n(std::size_t n) {
+    MyVector<T> out;
+    out.reserve(n < heap_.size() ? n : heap_.size());
+    while (n-- > 0 && heap_.size() > 0) {
+      out.push_back(std::move(heap_[std::size_t(0)]));
+      pop();
+    }
+    return out;
+  }
+
+  void clear() { heap_.clear(); }
+
+  /* Hands back the underlying storage, in heap order, and leaves the heap
+     empty */
+  MyVector<T> release() {
+    MyVector<T> out(std::move(heap_));
+    return out;
+  }
+
+ private:
+  MyVector<T> heap_;
+  Compare comp_;
+};
+
+/* DaryHeap over items named by a dense id in [0, n), with a position map
+   from id to heap slot so an item's priority can be changed or removed in
+   O(log n). Each heap slot stores the value next to its id, so sifting
+   never has to chase the id to compare. */
+template <typename T, std::size_t D = 4, typename Compare = std::less<T>>
+class IndexedDaryHeap {
+  static_assert(D >= 2, "A heap node needs at least two children");
+
+ public:
+  using ValueType = T;
+  using IdType = std::size_t;
+
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+ public:
+  IndexedDaryHeap() = default;
+
+  explicit IndexedDaryHeap(const Compare &comp) : comp_(comp) {}
+
+  /* Element access */
+
+  const T& top() const {
+    CheckNotEmpty("top()");
+    return heap_[std::size_t(0)].value;
+  }
+
+  IdType top_id() const {
+    CheckNotEmpty("top_id()");
+    return heap_[std::size_t(0)].id;
+  }
+
+  bool contains(IdType id) const {
+    return id < pos_.size() && pos_[id] != npos;
+  }
+
+  const T& value(IdType id) const {
+    CheckContains(id);
+    return heap_[pos_[id]].value;
+  }
+
+  /* Capacity */
+
+  std::size_t size() const { return heap_.size(); }
+
+  bool empty() const { return heap_.size() == 0; }
+
+  /* Sizes the position map for ids below n up front */
+  void reserve(std::size_t n) {
+    heap_.reserve(n);
+    GrowIds(n);
+  }
+
+  /* Modifiers */
+
+  void push(IdType id, const T &value) {
+    if (contains(id)) {
+      throw std::invalid_argument("Id is already in the IndexedDaryHeap");
+    }
+    GrowIds(id + 1);
+    heap_.push_back(Entry {value, id});
+    SiftUp(heap_.size() - 1);
+  }
+
+  void pop() {
+    CheckNotEmpty("pop()");
+    RemoveAt(0);
+  }
+
+  void erase(IdType id) {
+    CheckContains(id);
+    RemoveAt(pos_[id]);
+  }
+
+  /* Raises id towards the top. value must not rank below the current one;
+     the name comes from the min heap case, Compare = std::greater. */
+  void decrease_key(IdType id, const T &value) {
+    CheckContains(id);
+    std::size_t i = pos_[id];
+    if (comp_(value, heap_[i].value)) {
+      throw std::invalid_argument("decrease_key() would lower the priority");
+    }
+    heap_[i].value = value;
+    SiftUp(i);
+  }
+
+  /* Sets a new value for id in either direction */
+  void update(IdType id, const T &value) {
+    CheckContains(id);
+    std::size_t i = pos_[id];
+    bool up = comp_(heap_[i].value, value);
+    heap_[i].value = value;
+    if (up) {
+      SiftUp(i);
+    } else {
+      SiftDown(i);
+    }
+  }
+
+  void clear() {
+    for (std::size_t i {0}; i < heap_.size(); i++) {
+      pos_[heap_[i].id] = npos;
+    }
+    heap_.clear();
+  }
+
+ private:
+  struct Entry {
+    T value;
+    IdType id;
+  };
+
+  struct EntryLess {
+    bool operator()(const Entry &a, const Entry &b) const { return comp(a.value, b.value); }
+    const Compare &comp;
+  };
+
+  void CheckContains(IdType id) const {
+    if (!contains(id)) {
+      throw std::out_of_range("Id is not in the IndexedDaryHeap");
+    }
+  }
+
+  void CheckNotEmpty(const char* what) const {
+    if (heap_.size() == 0) {
+      throw std::out_of_range(std::string(what) + " on an empty IndexedDaryHeap");
+    }
+  }
+
+  void GrowIds(std::size_t n) {
+    while (pos_.size() < n) {
+      pos_.push_back(npos);
+    }
+  }
+
+  void SiftUp(std::size_t i) {
+    Entry* heap = heap_.data();
+    MyVector<std::size_t> &pos = pos_;
+    detail::SiftUp<D>(heap, i, EntryLess {comp_}, [heap, &pos](std::size_t j) {
+      pos[heap[j].id] = j;
+    });
+  }
+
+  void SiftDown(std::size_t i) {
+    Entry* heap = heap_.data();
+    MyVector<std::size_t> &pos = pos_;
+    detail::SiftDown<D>(heap, heap_.size(), i, EntryLess {comp_}, [heap, &pos](std::size_t j) {
+      pos[heap[j].id] = j;
+    });
+  }
+
+  /* Fills slot i from the last entry, which may then need to move either
+     way */
+  void RemoveAt(std::size_t i) {
+    pos_[heap_[i].id] = npos;
+    std::size_t last = heap_.size() - 1;
+    if (i != last) {
+      heap_[i] = std::move(heap_[last]);
+      pos_[heap_[i].id] = i;
+    }
+    heap_.pop_back();
+    if (i < heap_.size()) {
+      if (i > 0 && comp_(heap_[(i - 1) / D].value, heap_[i].value)) {
+        SiftUp(i);
+      } else {
+        SiftDown(i);
+      }
+    }
+  }
+
+  MyVector<Entry> heap_;
+  MyVector<std::size_t> pos_; // Heap slot of each id, npos when absent
+  Compare comp_;
+};
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,70 @@
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "../DaryHeap.h"
+
+// DaryHeap at arity 2, 4 and 8 against std::priority_queue. Fill pushes n
+// random keys and pops them all; Hold keeps n keys queued and times one pop
+// plus one push per iteration, the steady state of a scheduler.
+
+static std::vector<std::uint64_t> RandomKeys(std::size_t n) {
+  std::mt19937_64 rng(42);
+  std::vector<std::uint64_t> keys(n);
+  for (auto &k : keys) {
+    k = rng();
+  }
+  return keys;
+}
+
+template <typename Heap>
+static void BM_Fill(benchmark::State &state) {
+  auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    Heap heap;
+    for (auto k : keys) {
+      heap.push(k);
+    }
+    std::uint64_t sum {0};
+    while (!heap.empty()) {
+      sum += heap.top();
+      heap.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Heap>
+static void BM_Hold(benchmark::State &state) {
+  auto keys = RandomKeys(state.range(0));
+  Heap heap;
+  for (auto k : keys) {
+    heap.push(k);
+  }
+  std::mt19937_64 rng(7);
+  for (auto _ : state) {
+    std::uint64_t top = heap.top();
+    heap.pop();
+    heap.push(top - (rng() >> 8)); // Reinsert somewhere below the old top
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+using StdHeap = std::priority_queue<std::uint64_t>;
+using Heap2 = my::DaryHeap<std::uint64_t, 2>;
+using Heap4 = my::DaryHeap<std::uint64_t, 4>;
+using Heap8 = my::DaryHeap<std::uint64_t, 8>;
+
+BENCHMARK_TEMPLATE(BM_Fill, StdHeap)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Fill, Heap2)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Fill, Heap4)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Fill, Heap8)->RangeMultiplier(10)->Range(1000, 10000000);
+
+BENCHMARK_TEMPLATE(BM_Hold, StdHeap)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Hold, Heap2)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Hold, Heap4)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Hold, Heap8)->RangeMultiplier(10)->Range(1000, 10000000);
+
+BENCHMARK_MAIN();
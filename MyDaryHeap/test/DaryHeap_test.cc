@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../DaryHeap.h"
+
+using my::DaryHeap;
+using my::IndexedDaryHeap;
+
+TEST(DaryHeapTest, PushPopMatchesPriorityQueue) {
+  DaryHeap<int, 4> heap;
+  std::priority_queue<int> ref;
+  std::mt19937 rng(1);
+  for (int i {0}; i < 20000; i++) {
+    if (rng() % 3 == 0 && !ref.empty()) {
+      ASSERT_EQ(heap.top(), ref.top());
+      heap.pop();
+      ref.pop();
+    } else {
+      int x = rng() % 1000;
+      heap.push(x);
+      ref.push(x);
+    }
+  }
+  ASSERT_EQ(heap.size(), ref.size());
+  while (!ref.empty()) {
+    ASSERT_EQ(heap.top(), ref.top());
+    heap.pop();
+    ref.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(DaryHeapTest, MinHeapWithEightChildren) {
+  DaryHeap<int, 8, std::greater<int>> heap;
+  for (int x : {5, 3, 9, 1, 7, 2, 8, 6, 4, 0}) {
+    heap.push(x);
+  }
+  for (int i {0}; i < 10; i++) {
+    EXPECT_EQ(heap.top(), i);
+    heap.pop();
+  }
+}
+
+TEST(DaryHeapTest, HeapifyFromMyVector) {
+  MyVector<int> values;
+  for (int i {0}; i < 1000; i++) {
+    values.push_back((i * 37) % 1000);
+  }
+  DaryHeap<int> heap(std::move(values));
+  EXPECT_EQ(heap.size(), 1000);
+  for (int i {999}; i >= 0; i--) {
+    ASSERT_EQ(heap.top(), i);
+    heap.pop();
+  }
+}
+
+TEST(DaryHeapTest, PushRange) {
+  DaryHeap<int> heap;
+  std::vector<int> big {4, 8, 1, 9, 3};
+  heap.push_range(big.begin(), big.end()); // Rebuild path
+  std::vector<int> small {7};
+  heap.push_range(small.begin(), small.end()); // Sift up path
+  MyVector<int> out = heap.pop_n(100);
+  ASSERT_EQ(out.size(), 6);
+  int expected[] {9, 8, 7, 4, 3, 1};
+  for (std::size_t i {0}; i < out.size(); i++) {
+    EXPECT_EQ(out[i], expected[i]);
+  }
+}
+
+TEST(DaryHeapTest, PopN) {
+  DaryHeap<int, 4, std::greater<int>> heap;
+  for (int i {10}; i > 0; i--) {
+    heap.push(i);
+  }
+  MyVector<int> out = heap.pop_n(3);
+  ASSERT_EQ(out.size(), 3);
+  EXPECT_EQ(out[0], 1);
+  EXPECT_EQ(out[2], 3);
+  EXPECT_EQ(heap.size(), 7);
+  EXPECT_EQ(heap.top(), 4);
+}
+
+TEST(DaryHeapTest, EmptyThrows) {
+  DaryHeap<int> heap;
+  EXPECT_THROW(heap.top(), std::out_of_range);
+  EXPECT_THROW(heap.pop(), std::out_of_range);
+}
+
+TEST(IndexedDaryHeapTest, EmptyThrows) {
+  IndexedDaryHeap<int> heap;
+  EXPECT_THROW(heap.top(), std::out_of_range);
+  EXPECT_THROW(heap.top_id(), std::out_of_range);
+  EXPECT_THROW(heap.pop(), std::out_of_range);
+  heap.push(3, 10);
+  heap.pop();
+  EXPECT_THROW(heap.top(), std::out_of_range);
+}
+
+TEST(IndexedDaryHeapTest, DecreaseKeyAndUpdate) {
+  IndexedDaryHeap<int, 4, std::greater<int>> heap;
+  for (std::size_t id {0}; id < 10; id++) {
+    heap.push(id, 100 + int(id));
+  }
+  EXPECT_EQ(heap.top_id(), 0);
+  heap.decrease_key(7, 5);
+  EXPECT_EQ(heap.top_id(), 7);
+  EXPECT_EQ(heap.value(7), 5);
+  EXPECT_THROW(heap.decrease_key(7, 50), std::invalid_argument);
+  heap.update(7, 1000);
+  EXPECT_EQ(heap.top_id(), 0);
+  heap.erase(0);
+  EXPECT_FALSE(heap.contains(0));
+  EXPECT_EQ(heap.top_id(), 1);
+  EXPECT_THROW(heap.push(1, 3), std::invalid_argument);
+  EXPECT_THROW(heap.erase(0), std::out_of_range);
+}
+
+TEST(IndexedDaryHeapTest, DijkstraStyleRandomOps) {
+  IndexedDaryHeap<int, 4, std::greater<int>> heap;
+  std::vector<int> ref(500, -1); // -1 when absent
+  std::mt19937 rng(5);
+  for (int step {0}; step < 20000; step++) {
+    std::size_t id = rng() % ref.size();
+    int value = rng() % 10000;
+    if (ref[id] < 0) {
+      heap.push(id, value);
+      ref[id] = value;
+    } else if (rng() % 4 == 0) {
+      heap.erase(id);
+      ref[id] = -1;
+    } else {
+      heap.update(id, value);
+      ref[id] = value;
+    }
+  }
+  while (!heap.empty()) {
+    int best = *std::min_element(ref.begin(), ref.end(), [](int a, int b) {
+      return (a < 0 ? 1 << 30 : a) < (b < 0 ? 1 << 30 : b);
+    });
+    ASSERT_EQ(heap.top(), best);
+    ASSERT_EQ(ref[heap.top_id()], best);
+    ref[heap.top_id()] = -1;
+    heap.pop();
+  }
+}
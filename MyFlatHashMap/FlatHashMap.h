@@ -0,0 +1,348 @@
+/*
+   Open addressing hash map with SwissTable style control bytes
+*/
+
+#ifndef MY_FLAT_HASH_MAP_H
+#define MY_FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "../MyVector/MyVector.h"
+
+namespace my {
+
+/* Transparent string hash, so a FlatHashMap<std::string, V, StringHash> can
+   be searched with a std::string_view or const char* without building a
+   std::string */
+struct StringHash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view s) const {
+    return std::hash<std::string_view>()(s);
+  }
+};
+
+namespace detail {
+
+/* A group of 16 control bytes, matched 16 at a time with SSE2 where it is
+   available. Bit i of a match mask is set when byte i matched. */
+class ControlGroup {
+ public:
+  static constexpr std::size_t kWidth = 16;
+
+  explicit ControlGroup(const std::uint8_t* ctrl) {
+#if defined(__SSE2__)
+    group_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+    for (std::size_t i {0}; i < kWidth; i++) {
+      group_[i] = ctrl[i];
+    }
+#endif
+  }
+
+  std::uint32_t Match(std::uint8_t byte) const {
+#if defined(__SSE2__)
+    return static_cast<std::uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(group_, _mm_set1_epi8(static_cast<char>(byte)))));
+#else
+    std::uint32_t mask {0};
+    for (std::size_t i {0}; i < kWidth; i++) {
+      mask |= std::uint32_t(group_[i] == byte) << i;
+    }
+    return mask;
+#endif
+  }
+
+ private:
+#if defined(__SSE2__)
+  __m128i group_;
+#else
+  std::uint8_t group_[kWidth];
+#endif
+};
+
+template <typename H, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename H>
+struct IsTransparent<H, std::void_t<typename H::is_transparent>> : std::true_type {};
+
+} // namespace detail
+
+/* Entries live densely in insertion order (until an erase moves the last
+   one into the hole), so iteration is a linear scan. The table itself is a
+   control byte per slot, 0x80 for empty or the top 7 hash bits for a full
+   slot, plus the entry index it points at. Probing is linear but checks 16
+   control bytes per step, and because it is linear an erase can shift the
+   following run back instead of leaving a tombstone. Mutating a key through
+   an iterator is not allowed. */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class FlatHashMap {
+ public:
+  using KeyType = K;
+  using MappedType = V;
+  using ValueType = std::pair<K, V>;
+  using Iterator = ValueType*;
+  using ConstIterator = const ValueType*;
+
+ public:
+  FlatHashMap() = default;
+
+  FlatHashMap(std::initializer_list<ValueType> elements) {
+    reserve(elements.size());
+    for (const auto &element : elements) {
+      insert(element.first, element.second);
+    }
+  }
+
+  /* Capacity */
+
+  std::size_t size() const { return entries_.size(); }
+
+  bool empty() const { return entries_.size() == 0; }
+
+  /* Number of slots in the table */
+  std::size_t bucket_count() const { return capacity_; }
+
+  double load_factor() const { return capacity_ ? double(size()) / capacity_ : 0.0; }
+
+  /* Makes room for n entries without rehashing */
+  void reserve(std::size_t n) {
+    entries_.reserve(n);
+    hashes_.reserve(n);
+    std::size_t cap = kMinCapacity;
+    while (cap * kMaxLoadNum / kMaxLoadDen < n) {
+      cap *= 2;
+    }
+    if (cap > capacity_) {
+      Rehash(cap);
+    }
+  }
+
+  void clear() {
+    entries_.clear();
+    hashes_.clear();
+    for (std::size_t i {0}; i < ctrl_.size(); i++) {
+      ctrl_[i] = kEmpty;
+    }
+  }
+
+  /* Lookup. The key can be any type Hash and operator== accept when Hash
+     is transparent. */
+
+  template <typename Key = K, typename = std::enable_if_t<
+            std::is_same<Key, K>::value || detail::IsTransparent<Hash>::value>>
+  Iterator find(const Key &key) {
+    std::size_t slot = FindSlot(key, Mix(hasher_(key)));
+    return slot == kNotFound ? end() : entries_.data() + slots_[slot];
+  }
+
+  template <typename Key = K, typename = std::enable_if_t<
+            std::is_same<Key, K>::value || detail::IsTransparent<Hash>::value>>
+  ConstIterator find(const Key &key) const {
+    std::size_t slot = FindSlot(key, Mix(hasher_(key)));
+    return slot == kNotFound ? end() : entries_.data() + slots_[slot];
+  }
+
+  template <typename Key = K, typename = std::enable_if_t<
+            std::is_same<Key, K>::value || detail::IsTransparent<Hash>::value>>
+  bool contains(const Key &key) const {
+    return FindSlot(key, Mix(hasher_(key))) != kNotFound;
+  }
+
+  std::size_t count(const K &key) const { return contains(key) ? 1 : 0; }
+
+  V& at(const K &key) {
+    Iterator it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("Key not found in FlatHashMap");
+    }
+    return it->second;
+  }
+
+  V& operator[](const K &key) {
+    std::size_t hash = Mix(hasher_(key));
+    std::size_t slot = FindSlot(key, hash);
+    if (slot != kNotFound) {
+      return entries_[std::size_t(slots_[slot])].second;
+    }
+    return Insert(ValueType(key, V()), hash).second;
+  }
+
+  /* Modifiers */
+
+  /* Returns false (and leaves the map untouched) if the key already exists */
+  bool insert(const K &key, const V &value) {
+    std::size_t hash = Mix(hasher_(key));
+    if (FindSlot(key, hash) != kNotFound) {
+      return false;
+    }
+    Insert(ValueType(key, value), hash);
+    return true;
+  }
+
+  bool insert(const ValueType &element) {
+    return insert(element.first, element.second);
+  }
+
+  std::size_t erase(const K &key) {
+    std::size_t slot = FindSlot(key, Mix(hasher_(key)));
+    if (slot == kNotFound) {
+      return 0;
+    }
+    std::size_t index = slots_[slot];
+    ShiftBack(slot);
+
+    // Keep the entries dense: the last one moves into the hole.
+    std::size_t last = entries_.size() - 1;
+    if (index != last) {
+      slots_[SlotOfEntry(last)] = static_cast<std::uint32_t>(index);
+      entries_[index] = std::move(entries_[last]);
+      hashes_[index] = hashes_[last];
+    }
+    entries_.pop_back();
+    hashes_.pop_back();
+    return 1;
+  }
+
+  /* Iterators */
+
+  Iterator begin() { return entries_.data(); }
+  Iterator end() { return entries_.data() + entries_.size(); }
+  ConstIterator begin() const { return entries_.data(); }
+  ConstIterator end() const { return entries_.data() + entries_.size(); }
+
+ private:
+  static constexpr std::uint8_t kEmpty = 0x80;
+  static constexpr std::size_t kGroup = detail::ControlGroup::kWidth;
+  static constexpr std::size_t kMinCapacity = 16;
+  static constexpr std::size_t kMaxLoadNum = 7;
+  static constexpr std::size_t kMaxLoadDen = 8;
+  static constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+
+  /* Spreads weak hashes (std::hash of an integer is the identity) over all
+     bits, since both the home slot and the control byte come from it */
+  static std::size_t Mix(std::size_t h) {
+    std::uint64_t x = static_cast<std::uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(x ^ (x >> 32));
+  }
+
+  static std::uint8_t H2(std::size_t hash) { return hash & 0x7F; }
+
+  std::size_t Home(std::size_t hash) const { return (hash >> 7) & (capacity_ - 1); }
+
+  /* The first kGroup control bytes are mirrored after the last slot so a
+     group load starting near the end never has to wrap */
+  void SetCtrl(std::size_t slot, std::uint8_t value) {
+    ctrl_[slot] = value;
+    if (slot < kGroup) {
+      ctrl_[capacity_ + slot] = value;
+    }
+  }
+
+  template <typename Key>
+  std::size_t FindSlot(const Key &key, std::size_t hash) const {
+    if (capacity_ == 0) {
+      return kNotFound;
+    }
+    std::size_t mask = capacity_ - 1;
+    std::size_t pos = Home(hash);
+    while (true) {
+      detail::ControlGroup group(ctrl_.data() + pos);
+      for (std::uint32_t m = group.Match(H2(hash)); m != 0; m &= m - 1) {
+        std::size_t slot = (pos + __builtin_ctz(m)) & mask;
+        if (entries_[std::size_t(slots_[slot])].first == key) {
+          return slot;
+        }
+      }
+      if (group.Match(kEmpty) != 0) {
+        return kNotFound;
+      }
+      pos = (pos + kGroup) & mask;
+    }
+  }
+
+  /* First empty slot at or after the home slot of hash */
+  std::size_t FindEmpty(std::size_t hash) const {
+    std::size_t mask = capacity_ - 1;
+    std::size_t pos = Home(hash);
+    while (true) {
+      std::uint32_t m = detail::ControlGroup(ctrl_.data() + pos).Match(kEmpty);
+      if (m != 0) {
+        return (pos + __builtin_ctz(m)) & mask;
+      }
+      pos = (pos + kGroup) & mask;
+    }
+  }
+
+  std::size_t SlotOfEntry(std::size_t index) const {
+    std::size_t mask = capacity_ - 1;
+    std::size_t slot = Home(hashes_[index]);
+    while (ctrl_[slot] == kEmpty || slots_[slot] != index) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  ValueType& Insert(ValueType &&element, std::size_t hash) {
+    if ((entries_.size() + 1) * kMaxLoadDen > capacity_ * kMaxLoadNum) {
+      Rehash(capacity_ == 0 ? kMinCapacity : capacity_ * 2);
+    }
+    std::size_t slot = FindEmpty(hash);
+    SetCtrl(slot, H2(hash));
+    slots_[slot] = static_cast<std::uint32_t>(entries_.size());
+    entries_.push_back(std::move(element));
+    hashes_.push_back(hash);
+    return entries_[entries_.size() - 1];
+  }
+
+  /* Backward shift deletion: pull every later member of the probe run that
+     may legally sit in the hole back into it, then empty the last hole */
+  void ShiftBack(std::size_t hole) {
+    std::size_t mask = capacity_ - 1;
+    for (std::size_t j = (hole + 1) & mask; ctrl_[j] != kEmpty; j = (j + 1) & mask) {
+      std::size_t home = Home(hashes_[std::size_t(slots_[j])]);
+      if (((j - home) & mask) >= ((j - hole) & mask)) {
+        SetCtrl(hole, ctrl_[j]);
+        slots_[hole] = slots_[j];
+        hole = j;
+      }
+    }
+    SetCtrl(hole, kEmpty);
+  }
+
+  /* Rebuilds the table at a new capacity from the stored hashes; the
+     entries themselves do not move */
+  void Rehash(std::size_t cap) {
+    capacity_ = cap;
+    ctrl_.assign(cap + kGroup, kEmpty);
+    slots_.assign(cap, 0);
+    for (std::size_t i {0}; i < entries_.size(); i++) {
+      std::size_t slot = FindEmpty(hashes_[i]);
+      SetCtrl(slot, H2(hashes_[i]));
+      slots_[slot] = static_cast<std::uint32_t>(i);
+    }
+  }
+
+  MyVector<ValueType> entries_;     // Dense key/value pairs
+  MyVector<std::size_t> hashes_;    // Mixed hash of each entry
+  MyVector<std::uint8_t> ctrl_;     // Control byte per slot, plus the mirrored first group
+  MyVector<std::uint32_t> slots_;   // Entry index per slot
+  std::size_t capacity_ = 0;        // Number of slots, a power of two
+  Hash hasher_;
+};
+
+} // Namespace bracket
+
+#endif
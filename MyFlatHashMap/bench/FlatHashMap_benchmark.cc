@@ -0,0 +1,141 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "../FlatHashMap.h"
+
+// FlatHashMap against std::unordered_map for integer and string keys.
+// Insert and erase time a whole map of n keys per iteration; the find
+// benchmarks look up keys that are all present (hit) or all absent (miss).
+
+template <typename K>
+static K MakeKey(std::uint64_t x);
+
+template <>
+std::uint64_t MakeKey<std::uint64_t>(std::uint64_t x) { return x; }
+
+template <>
+std::string MakeKey<std::string>(std::uint64_t x) { return "key:" + std::to_string(x); }
+
+template <typename K>
+static std::vector<K> RandomKeys(std::size_t n, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<K> keys;
+  keys.reserve(n);
+  for (std::size_t i {0}; i < n; i++) {
+    keys.push_back(MakeKey<K>(rng()));
+  }
+  return keys;
+}
+
+template <typename K>
+static std::vector<K> Probes(const std::vector<K> &keys) {
+  std::mt19937_64 rng(7);
+  std::vector<K> probes(1 << 16);
+  for (auto &p : probes) {
+    p = keys[rng() % keys.size()];
+  }
+  return probes;
+}
+
+template <typename K, typename V, typename H>
+static void Insert(my::FlatHashMap<K, V, H> &map, const K &key) { map.insert(key, V()); }
+
+template <typename K, typename V>
+static void Insert(std::unordered_map<K, V> &map, const K &key) { map.emplace(key, V()); }
+
+template <typename Map, typename K>
+static void Fill(Map &map, const std::vector<K> &keys) {
+  map.reserve(keys.size());
+  for (const auto &k : keys) {
+    Insert(map, k);
+  }
+}
+
+template <typename Map, typename K>
+static void BM_Insert(benchmark::State &state) {
+  auto keys = RandomKeys<K>(state.range(0), 42);
+  for (auto _ : state) {
+    Map map;
+    for (const auto &k : keys) {
+      Insert(map, k);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Map, typename K>
+static void FindBenchmark(benchmark::State &state, const std::vector<K> &probes, const Map &map) {
+  std::size_t i {0};
+  std::size_t found {0};
+  for (auto _ : state) {
+    found += map.find(probes[i & (probes.size() - 1)]) != map.end();
+    i++;
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Map, typename K>
+static void BM_FindHit(benchmark::State &state) {
+  auto keys = RandomKeys<K>(state.range(0), 42);
+  Map map;
+  Fill(map, keys);
+  FindBenchmark(state, Probes(keys), map);
+}
+
+template <typename Map, typename K>
+static void BM_FindMiss(benchmark::State &state) {
+  auto keys = RandomKeys<K>(state.range(0), 42);
+  Map map;
+  Fill(map, keys);
+  FindBenchmark(state, Probes(RandomKeys<K>(1 << 16, 99)), map);
+}
+
+template <typename Map, typename K>
+static void BM_Erase(benchmark::State &state) {
+  auto keys = RandomKeys<K>(state.range(0), 42);
+  for (auto _ : state) {
+    state.PauseTiming();
+    Map map;
+    Fill(map, keys);
+    state.ResumeTiming();
+    for (const auto &k : keys) {
+      map.erase(k);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+using FlatInt = my::FlatHashMap<std::uint64_t, std::uint64_t>;
+using StdInt = std::unordered_map<std::uint64_t, std::uint64_t>;
+using FlatString = my::FlatHashMap<std::string, std::uint64_t, my::StringHash>;
+using StdString = std::unordered_map<std::string, std::uint64_t>;
+
+// String keys stop at 1e7, 1e8 of them do not fit in memory next to the map
+#define INT_RANGE RangeMultiplier(10)->Range(1000, 100000000)
+#define STRING_RANGE RangeMultiplier(10)->Range(1000, 10000000)
+
+BENCHMARK_TEMPLATE(BM_Insert, FlatInt, std::uint64_t)->INT_RANGE;
+BENCHMARK_TEMPLATE(BM_Insert, StdInt, std::uint64_t)->INT_RANGE;
+BENCHMARK_TEMPLATE(BM_FindHit, FlatInt, std::uint64_t)->INT_RANGE;
+BENCHMARK_TEMPLATE(BM_FindHit, StdInt, std::uint64_t)->INT_RANGE;
+BENCHMARK_TEMPLATE(BM_FindMiss, FlatInt, std::uint64_t)->INT_RANGE;
+BENCHMARK_TEMPLATE(BM_FindMiss, StdInt, std::uint64_t)->INT_RANGE;
+BENCHMARK_TEMPLATE(BM_Erase, FlatInt, std::uint64_t)->INT_RANGE;
+BENCHMARK_TEMPLATE(BM_Erase, StdInt, std::uint64_t)->INT_RANGE;
+
+BENCHMARK_TEMPLATE(BM_Insert, FlatString, std::string)->STRING_RANGE;
+BENCHMARK_TEMPLATE(BM_Insert, StdString, std::string)->STRING_RANGE;
+BENCHMARK_TEMPLATE(BM_FindHit, FlatString, std::string)->STRING_RANGE;
+BENCHMARK_TEMPLATE(BM_FindHit, StdString, std::string)->STRING_RANGE;
+BENCHMARK_TEMPLATE(BM_FindMiss, FlatString, std::string)->STRING_RANGE;
+BENCHMARK_TEMPLATE(BM_FindMiss, StdString, std::string)->STRING_RANGE;
+BENCHMARK_TEMPLATE(BM_Erase, FlatString, std::string)->STRING_RANGE;
+BENCHMARK_TEMPLATE(BM_Erase, StdString, std::string)->STRING_RANGE;
+
+BENCHMARK_MAIN();
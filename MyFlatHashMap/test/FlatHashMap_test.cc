@@ -0,0 +1,110 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <gtest/gtest.h>
+#include "../FlatHashMap.h"
+
+using my::FlatHashMap;
+
+// Check a FlatHashMap against std::unordered_map, both ways
+template <typename K, typename V, typename H>
+void MapTest(FlatHashMap<K, V, H> &flat, std::unordered_map<K, V> &ref) {
+  ASSERT_EQ(flat.size(), ref.size());
+  for (const auto &kv : ref) {
+    auto it = flat.find(kv.first);
+    ASSERT_NE(it, flat.end());
+    EXPECT_EQ(it->second, kv.second);
+  }
+  for (const auto &kv : flat) {
+    EXPECT_EQ(ref.count(kv.first), 1);
+  }
+}
+
+TEST(FlatHashMapTest, DefaultConstructor) {
+  FlatHashMap<int, int> fm;
+  EXPECT_TRUE(fm.empty());
+  EXPECT_EQ(fm.find(3), fm.end());
+  EXPECT_EQ(fm.erase(3), 0);
+}
+
+TEST(FlatHashMapTest, InsertFindAndSubscript) {
+  FlatHashMap<int, int> fm {{1, 10}, {2, 20}};
+  EXPECT_FALSE(fm.insert(1, 11));
+  EXPECT_TRUE(fm.insert(3, 30));
+  fm[4] += 40;
+  EXPECT_EQ(fm.at(1), 10);
+  EXPECT_EQ(fm[4], 40);
+  EXPECT_EQ(fm.size(), 4);
+  EXPECT_THROW(fm.at(5), std::out_of_range);
+}
+
+TEST(FlatHashMapTest, GrowsPastManyGroups) {
+  FlatHashMap<int, int> fm;
+  std::unordered_map<int, int> m;
+  for (int i {0}; i < 10000; i++) {
+    fm.insert(i * 7, i);
+    m.emplace(i * 7, i);
+  }
+  MapTest(fm, m);
+  EXPECT_LE(fm.load_factor(), 0.875);
+  EXPECT_FALSE(fm.contains(3));
+}
+
+TEST(FlatHashMapTest, RandomInsertEraseMatchesStd) {
+  FlatHashMap<std::uint64_t, int> fm;
+  std::unordered_map<std::uint64_t, int> m;
+  std::mt19937_64 rng(3);
+  for (int i {0}; i < 50000; i++) {
+    std::uint64_t key = rng() % 2000;
+    if (rng() % 3 == 0) {
+      EXPECT_EQ(fm.erase(key), m.erase(key));
+    } else {
+      EXPECT_EQ(fm.insert(key, i), m.emplace(key, i).second);
+    }
+  }
+  MapTest(fm, m);
+}
+
+TEST(FlatHashMapTest, ReserveAvoidsRehash) {
+  FlatHashMap<int, int> fm;
+  fm.reserve(1000);
+  std::size_t buckets = fm.bucket_count();
+  for (int i {0}; i < 1000; i++) {
+    fm.insert(i, i);
+  }
+  EXPECT_EQ(fm.bucket_count(), buckets);
+}
+
+TEST(FlatHashMapTest, DenseIteration) {
+  FlatHashMap<int, int> fm {{1, 1}, {2, 2}, {3, 3}};
+  fm.erase(1);
+  EXPECT_EQ(fm.end() - fm.begin(), 2);
+  int sum {0};
+  for (const auto &kv : fm) {
+    sum += kv.second;
+  }
+  EXPECT_EQ(sum, 5);
+}
+
+TEST(FlatHashMapTest, HeterogeneousFind) {
+  FlatHashMap<std::string, int, my::StringHash> fm;
+  fm["alpha"] = 1;
+  fm["beta"] = 2;
+  std::string_view key = "beta";
+  EXPECT_EQ(fm.find(key)->second, 2);
+  EXPECT_TRUE(fm.contains("alpha"));
+  EXPECT_FALSE(fm.contains(std::string_view("gamma")));
+  EXPECT_EQ(fm.erase("alpha"), 1);
+  EXPECT_EQ(fm.size(), 1);
+}
+
+TEST(FlatHashMapTest, ClearMethod) {
+  FlatHashMap<int, int> fm {{1, 1}, {2, 2}};
+  fm.clear();
+  EXPECT_TRUE(fm.empty());
+  EXPECT_FALSE(fm.contains(1));
+  fm.insert(1, 5);
+  EXPECT_EQ(fm.at(1), 5);
+}
@@ -0,0 +1,410 @@
+/*
+   Sorted associative containers stored in MyVector columns
+*/
+
+#ifndef MY_FLAT_MAP_H
+#define MY_FLAT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "../MyVector/MyVector.h"
+
+namespace my {
+
+namespace detail {
+
+/* Lower bound over a sorted range. The loop always runs log2(n) times and
+   the only data dependent step is a select, so the compiler can emit a cmov
+   instead of a hard to predict branch. */
+template <typename K, typename Key, typename Compare>
+std::size_t BranchlessLowerBound(const K* first, std::size_t n, const Key& key, Compare comp) {
+  if (n == 0) {
+    return 0;
+  }
+  const K* base = first;
+  while (n > 1) {
+    std::size_t half = n / 2;
+    base = comp(base[half], key) ? base + half : base;
+    n -= half;
+  }
+  return (base - first) + comp(*base, key);
+}
+
+/* Sorts a batch of pairs by key and keeps the first occurrence of every key */
+template <typename Pair, typename Compare>
+std::size_t SortUnique(Pair* first, std::size_t n, Compare comp) {
+  std::stable_sort(first, first + n, [&](const Pair& a, const Pair& b) {
+    return comp(a.first, b.first);
+  });
+  std::size_t out {0};
+  for (std::size_t i {0}; i < n; i++) {
+    if (out == 0 || comp(first[out - 1].first, first[i].first)) {
+      if (out != i) {
+        first[out] = std::move(first[i]);
+      }
+      out++;
+    }
+  }
+  return out;
+}
+
+} // namespace detail
+
+template <typename K, typename V, typename Compare = std::less<K>>
+class FlatMap {
+ public:
+  using KeyType = K;
+  using MappedType = V;
+
+  /* Keys and values live in separate columns, so dereferencing hands out a
+     pair of references rather than a reference to a stored pair. */
+  struct Reference {
+    const K& first;
+    V& second;
+    const Reference* operator->() const { return this; }
+  };
+
+  class Iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::pair<K, V>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Reference;
+    using reference = Reference;
+
+    Iterator(const K* key, V* value) : key_(key), value_(value) {}
+
+    Reference operator*() const { return Reference{*key_, *value_}; }
+    Reference operator->() const { return **this; }
+
+    Iterator& operator++() { key_++; value_++; return *this; }
+    Iterator operator++(int) { Iterator tmp = *this; ++*this; return tmp; }
+    Iterator& operator--() { key_--; value_--; return *this; }
+    Iterator operator--(int) { Iterator tmp = *this; --*this; return tmp; }
+    Iterator operator+(difference_type i) const { return Iterator(key_ + i, value_ + i); }
+    Iterator operator-(difference_type i) const { return Iterator(key_ - i, value_ - i); }
+    difference_type operator-(const Iterator& rhs) const { return key_ - rhs.key_; }
+
+    bool operator==(const Iterator& rhs) const { return key_ == rhs.key_; }
+    bool operator!=(const Iterator& rhs) const { return key_ != rhs.key_; }
+
+   private:
+    const K* key_;
+    V* value_;
+  };
+
+  /* The underlying columns, handed out by extract() */
+  struct Columns {
+    MyVector<K> keys;
+    MyVector<V> values;
+  };
+
+ public:
+  FlatMap() = default;
+
+  FlatMap(std::initializer_list<std::pair<K, V>> elements) {
+    insert_range(elements.begin(), elements.end());
+  }
+
+  /* Capacity */
+
+  std::size_t size() const { return keys_.size(); }
+
+  bool empty() const { return keys_.size() == 0; }
+
+  void reserve(std::size_t cap) {
+    keys_.reserve(cap);
+    values_.reserve(cap);
+  }
+
+  void clear() {
+    keys_.clear();
+    values_.clear();
+  }
+
+  /* Lookup */
+
+  Iterator lower_bound(const K& key) {
+    return begin() + LowerBoundIndex(key);
+  }
+
+  Iterator find(const K& key) {
+    std::size_t i = LowerBoundIndex(key);
+    if (i == keys_.size() || comp_(key, keys_[i])) {
+      return end();
+    }
+    return begin() + i;
+  }
+
+  bool contains(const K& key) const {
+    std::size_t i = LowerBoundIndex(key);
+    return i != keys_.size() && !comp_(key, keys_[i]);
+  }
+
+  std::size_t count(const K& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  V& at(const K& key) const {
+    std::size_t i = LowerBoundIndex(key);
+    if (i == keys_.size() || comp_(key, keys_[i])) {
+      throw std::out_of_range("Key not found in FlatMap");
+    }
+    return values_[i];
+  }
+
+  V& operator[](const K& key) {
+    std::size_t i = LowerBoundIndex(key);
+    if (i == keys_.size() || comp_(key, keys_[i])) {
+      InsertAt(i, K(key), V());
+    }
+    return values_[i];
+  }
+
+  /* Modifiers */
+
+  /* Returns false (and leaves the map untouched) if the key already exists */
+  bool insert(const K& key, const V& value) {
+    std::size_t i = LowerBoundIndex(key);
+    if (i != keys_.size() && !comp_(key, keys_[i])) {
+      return false;
+    }
+    InsertAt(i, K(key), V(value));
+    return true;
+  }
+
+  bool insert(const std::pair<K, V>& element) {
+    return insert(element.first, element.second);
+  }
+
+  /* Bulk insert of key/value pairs. The batch is sorted and deduplicated on
+     its own, then merged into the columns from the back so every existing
+     element moves at most once. Keys already in the map keep their value. */
+  template <typename InputIt>
+  void insert_range(InputIt first, InputIt last) {
+    MyVector<std::pair<K, V>> batch;
+    for (; first != last; ++first) {
+      batch.push_back(std::pair<K, V>(*first));
+    }
+    std::size_t n = detail::SortUnique(batch.data(), batch.size(), comp_);
+
+    // Count the batch keys that are not already present.
+    std::size_t old_size = keys_.size();
+    std::size_t added {0};
+    for (std::size_t i {0}, j {0}; j < n; j++) {
+      while (i < old_size && comp_(keys_[i], batch[j].first)) {
+        i++;
+      }
+      if (i == old_size || comp_(batch[j].first, keys_[i])) {
+        added++;
+      }
+    }
+    if (added == 0) {
+      return;
+    }
+
+    reserve(old_size + added);
+    for (std::size_t i {0}; i < added; i++) {
+      keys_.push_back(K());
+      values_.push_back(V());
+    }
+
+    // Merge from the back: out is the next free slot, i walks the old
+    // columns and j walks the batch. Once out meets i every new key has been
+    // placed and the remaining prefix is already in position.
+    std::size_t out = old_size + added;
+    std::size_t i = old_size;
+    std::size_t j = n;
+    while (j > 0 && out > i) {
+      if (i > 0 && !comp_(keys_[i - 1], batch[j - 1].first)) {
+        if (!comp_(batch[j - 1].first, keys_[i - 1])) {
+          j--; // Duplicate of an existing key, keep the existing value
+          continue;
+        }
+        out--;
+        i--;
+        keys_[out] = std::move(keys_[i]);
+        values_[out] = std::move(values_[i]);
+      } else {
+        out--;
+        j--;
+        keys_[out] = std::move(batch[j].first);
+        values_[out] = std::move(batch[j].second);
+      }
+    }
+  }
+
+  std::size_t erase(const K& key) {
+    std::size_t i = LowerBoundIndex(key);
+    if (i == keys_.size() || comp_(key, keys_[i])) {
+      return 0;
+    }
+    for (std::size_t j {i + 1}; j < keys_.size(); j++) {
+      keys_[j - 1] = std::move(keys_[j]);
+      values_[j - 1] = std::move(values_[j]);
+    }
+    keys_.pop_back();
+    values_.pop_back();
+    return 1;
+  }
+
+  /* Moves the columns out, leaving the map empty */
+  Columns extract() {
+    Columns columns {std::move(keys_), std::move(values_)};
+    return columns;
+  }
+
+  /* Observers */
+
+  const MyVector<K>& keys() const { return keys_; }
+
+  const MyVector<V>& values() const { return values_; }
+
+  /* Iterators */
+
+  Iterator begin() { return Iterator(keys_.data(), values_.data()); }
+
+  Iterator end() { return Iterator(keys_.data() + keys_.size(), values_.data() + values_.size()); }
+
+ private:
+  std::size_t LowerBoundIndex(const K& key) const {
+    return detail::BranchlessLowerBound(keys_.data(), keys_.size(), key, comp_);
+  }
+
+  void InsertAt(std::size_t i, K&& key, V&& value) {
+    keys_.push_back(std::move(key));
+    values_.push_back(std::move(value));
+    std::size_t last = keys_.size() - 1;
+    if (i == last) {
+      return;
+    }
+    std::rotate(keys_.data() + i, keys_.data() + last, keys_.data() + last + 1);
+    std::rotate(values_.data() + i, values_.data() + last, values_.data() + last + 1);
+  }
+
+  MyVector<K> keys_;
+  MyVector<V> values_;
+  Compare comp_;
+};
+
+template <typename K, typename Compare = std::less<K>>
+class FlatSet {
+ public:
+  using KeyType = K;
+  using Iterator = const K*;
+
+ public:
+  FlatSet() = default;
+
+  FlatSet(std::initializer_list<K> elements) {
+    insert_range(elements.begin(), elements.end());
+  }
+
+  /* Capacity */
+
+  std::size_t size() const { return keys_.size(); }
+
+  bool empty() const { return keys_.size() == 0; }
+
+  void reserve(std::size_t cap) { keys_.reserve(cap); }
+
+  void clear() { keys_.clear(); }
+
+  /* Lookup */
+
+  Iterator lower_bound(const K& key) const {
+    return begin() + detail::BranchlessLowerBound(keys_.data(), keys_.size(), key, comp_);
+  }
+
+  Iterator find(const K& key) const {
+    Iterator it = lower_bound(key);
+    if (it == end() || comp_(key, *it)) {
+      return end();
+    }
+    return it;
+  }
+
+  bool contains(const K& key) const { return find(key) != end(); }
+
+  std::size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+
+  /* Modifiers */
+
+  bool insert(const K& key) {
+    std::size_t i = lower_bound(key) - begin();
+    if (i != keys_.size() && !comp_(key, keys_[i])) {
+      return false;
+    }
+    keys_.push_back(key);
+    std::rotate(keys_.data() + i, keys_.data() + keys_.size() - 1, keys_.data() + keys_.size());
+    return true;
+  }
+
+  /* Appends the batch, sorts the whole column once and drops duplicates in
+     the same pass. */
+  template <typename InputIt>
+  void insert_range(InputIt first, InputIt last) {
+    std::size_t old_size = keys_.size();
+    for (; first != last; ++first) {
+      keys_.push_back(*first);
+    }
+    if (keys_.size() == old_size) {
+      return;
+    }
+    K* data = keys_.data();
+    std::sort(data + old_size, data + keys_.size(), comp_);
+    std::inplace_merge(data, data + old_size, data + keys_.size(), comp_);
+    std::size_t out {0};
+    for (std::size_t i {0}; i < keys_.size(); i++) {
+      if (out == 0 || comp_(data[out - 1], data[i])) {
+        if (out != i) {
+          data[out] = std::move(data[i]);
+        }
+        out++;
+      }
+    }
+    while (keys_.size() > out) {
+      keys_.pop_back();
+    }
+  }
+
+  std::size_t erase(const K& key) {
+    Iterator it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    std::size_t i = it - begin();
+    std::move(keys_.data() + i + 1, keys_.data() + keys_.size(), keys_.data() + i);
+    keys_.pop_back();
+    return 1;
+  }
+
+  /* Moves the column out, leaving the set empty */
+  MyVector<K> extract() {
+    MyVector<K> keys {std::move(keys_)};
+    return keys;
+  }
+
+  /* Observers */
+
+  const MyVector<K>& keys() const { return keys_; }
+
+  /* Iterators */
+
+  Iterator begin() const { return keys_.data(); }
+
+  Iterator end() const { return keys_.data() + keys_.size(); }
+
+ private:
+  MyVector<K> keys_;
+  Compare comp_;
+};
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "../FlatMap.h"
+
+// Lookup throughput of FlatMap against the node based std containers.
+// Every benchmark builds a map of n random keys and then looks up keys
+// drawn from the same set, so all lookups hit.
+
+static std::vector<std::uint64_t> RandomKeys(std::size_t n) {
+  std::mt19937_64 rng(42);
+  std::vector<std::uint64_t> keys(n);
+  for (auto &k : keys) {
+    k = rng();
+  }
+  return keys;
+}
+
+static std::vector<std::uint64_t> Probes(const std::vector<std::uint64_t> &keys) {
+  std::mt19937_64 rng(7);
+  std::vector<std::uint64_t> probes(1 << 16);
+  for (auto &p : probes) {
+    p = keys[rng() % keys.size()];
+  }
+  return probes;
+}
+
+template <typename Map>
+static void LookupBenchmark(benchmark::State &state, Map &map, const std::vector<std::uint64_t> &probes) {
+  std::size_t i {0};
+  std::uint64_t sum {0};
+  for (auto _ : state) {
+    sum += map.find(probes[i & (probes.size() - 1)])->second;
+    i++;
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_FlatMapFind(benchmark::State &state) {
+  auto keys = RandomKeys(state.range(0));
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> pairs;
+  for (auto k : keys) {
+    pairs.emplace_back(k, k);
+  }
+  my::FlatMap<std::uint64_t, std::uint64_t> map;
+  map.insert_range(pairs.begin(), pairs.end());
+  LookupBenchmark(state, map, Probes(keys));
+}
+
+static void BM_StdMapFind(benchmark::State &state) {
+  auto keys = RandomKeys(state.range(0));
+  std::map<std::uint64_t, std::uint64_t> map;
+  for (auto k : keys) {
+    map.emplace(k, k);
+  }
+  LookupBenchmark(state, map, Probes(keys));
+}
+
+static void BM_StdUnorderedMapFind(benchmark::State &state) {
+  auto keys = RandomKeys(state.range(0));
+  std::unordered_map<std::uint64_t, std::uint64_t> map;
+  for (auto k : keys) {
+    map.emplace(k, k);
+  }
+  LookupBenchmark(state, map, Probes(keys));
+}
+
+BENCHMARK(BM_FlatMapFind)->RangeMultiplier(10)->Range(100, 10000000);
+BENCHMARK(BM_StdMapFind)->RangeMultiplier(10)->Range(100, 10000000);
+BENCHMARK(BM_StdUnorderedMapFind)->RangeMultiplier(10)->Range(100, 10000000);
+
+BENCHMARK_MAIN();
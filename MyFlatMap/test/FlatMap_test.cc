@@ -0,0 +1,123 @@
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../FlatMap.h"
+
+using my::FlatMap;
+using my::FlatSet;
+
+// Check a FlatMap against std::map entry by entry
+template <typename K, typename V>
+void MapTest(FlatMap<K, V> &flat, const std::map<K, V> &ref) {
+  ASSERT_EQ(flat.size(), ref.size());
+  auto it = flat.begin();
+  for (const auto &kv : ref) {
+    EXPECT_EQ(it->first, kv.first);
+    EXPECT_EQ(it->second, kv.second);
+    it++;
+  }
+}
+
+TEST(FlatMapTest, DefaultConstructor) {
+  FlatMap<int, int> fm;
+  EXPECT_TRUE(fm.empty());
+  EXPECT_EQ(fm.find(1), fm.end());
+}
+
+TEST(FlatMapTest, InsertKeepsOrder) {
+  FlatMap<int, std::string> fm;
+  std::map<int, std::string> m;
+  for (int k : {5, 1, 9, 3, 7, 1}) {
+    EXPECT_EQ(fm.insert(k, std::to_string(k)), m.insert({k, std::to_string(k)}).second);
+  }
+  MapTest(fm, m);
+}
+
+TEST(FlatMapTest, FindAndLowerBound) {
+  FlatMap<int, int> fm {{10, 1}, {20, 2}, {30, 3}};
+  EXPECT_EQ(fm.find(20)->second, 2);
+  EXPECT_EQ(fm.find(25), fm.end());
+  EXPECT_EQ(fm.lower_bound(25)->first, 30);
+  EXPECT_EQ(fm.lower_bound(5)->first, 10);
+  EXPECT_EQ(fm.lower_bound(31), fm.end());
+  EXPECT_TRUE(fm.contains(30));
+  EXPECT_FALSE(fm.contains(31));
+}
+
+TEST(FlatMapTest, AtAndSubscript) {
+  FlatMap<std::string, int> fm;
+  fm["b"] = 2;
+  fm["a"] = 1;
+  fm["b"] += 10;
+  EXPECT_EQ(fm.at("a"), 1);
+  EXPECT_EQ(fm.at("b"), 12);
+  EXPECT_THROW(fm.at("c"), std::out_of_range);
+}
+
+TEST(FlatMapTest, InsertRangeMergesAndDedups) {
+  FlatMap<int, int> fm {{2, 20}, {4, 40}, {6, 60}};
+  std::map<int, int> m {{2, 20}, {4, 40}, {6, 60}};
+  std::vector<std::pair<int, int>> batch {{5, 50}, {1, 10}, {4, 99}, {5, 98}, {8, 80}, {3, 30}};
+  fm.insert_range(batch.begin(), batch.end());
+  m.insert(batch.begin(), batch.end());
+  MapTest(fm, m);
+}
+
+TEST(FlatMapTest, InsertRangeOnlyDuplicates) {
+  FlatMap<int, int> fm {{1, 1}, {2, 2}};
+  std::vector<std::pair<int, int>> batch {{2, 5}, {1, 5}};
+  fm.insert_range(batch.begin(), batch.end());
+  EXPECT_EQ(fm.size(), 2);
+  EXPECT_EQ(fm.at(1), 1);
+}
+
+TEST(FlatMapTest, EraseMethod) {
+  FlatMap<int, std::string> fm {{1, "a"}, {2, "b"}, {3, "c"}};
+  std::map<int, std::string> m {{1, "a"}, {2, "b"}, {3, "c"}};
+  EXPECT_EQ(fm.erase(2), m.erase(2));
+  EXPECT_EQ(fm.erase(7), m.erase(7));
+  MapTest(fm, m);
+}
+
+TEST(FlatMapTest, ReserveAndExtract) {
+  FlatMap<int, int> fm;
+  fm.reserve(16);
+  EXPECT_GE(fm.keys().capacity(), 16);
+  fm.insert(2, 4);
+  fm.insert(1, 2);
+  auto columns = fm.extract();
+  EXPECT_TRUE(fm.empty());
+  ASSERT_EQ(columns.keys.size(), 2);
+  EXPECT_EQ(columns.keys[0], 1);
+  EXPECT_EQ(columns.values[1], 4);
+}
+
+TEST(FlatSetTest, InsertFindErase) {
+  FlatSet<int> fs;
+  std::set<int> s;
+  for (int k : {4, 2, 8, 2, 6}) {
+    EXPECT_EQ(fs.insert(k), s.insert(k).second);
+  }
+  EXPECT_EQ(fs.size(), s.size());
+  EXPECT_NE(fs.find(6), fs.end());
+  EXPECT_EQ(fs.find(5), fs.end());
+  EXPECT_EQ(*fs.lower_bound(5), 6);
+  EXPECT_EQ(fs.erase(4), s.erase(4));
+  EXPECT_TRUE(std::equal(fs.begin(), fs.end(), s.begin(), s.end()));
+}
+
+TEST(FlatSetTest, InsertRange) {
+  FlatSet<std::string> fs {"m", "c"};
+  std::set<std::string> s {"m", "c"};
+  std::vector<std::string> batch {"z", "a", "m", "a", "q"};
+  fs.insert_range(batch.begin(), batch.end());
+  s.insert(batch.begin(), batch.end());
+  EXPECT_TRUE(std::equal(fs.begin(), fs.end(), s.begin(), s.end()));
+  MyVector<std::string> keys = fs.extract();
+  EXPECT_EQ(keys.size(), s.size());
+  EXPECT_TRUE(fs.empty());
+}
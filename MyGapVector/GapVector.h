@@ -0,0 +1,196 @@
+/*
+   Gap buffer: a vector with cheap edits near a moving cursor
+*/
+
+#ifndef MY_GAP_VECTOR_H
+#define MY_GAP_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "../MyVector/MyVector.h"
+#include "IndexIterator.h"
+
+namespace my {
+
+/* Elements sit in one MyVector with a run of unused slots, the gap, at the
+   cursor. Inserting or erasing at the cursor only moves a gap boundary, and
+   moving the cursor by k shifts k elements across the gap, so a burst of
+   edits near one spot costs O(1) each after the first. Indexing stays O(1):
+   positions at or past the gap just skip over it. */
+template <typename T>
+class GapVector {
+ public:
+  using ValueType = T;
+  using PointerType = ValueType*;
+  using ReferenceType = ValueType&;
+  using Iterator = IndexIterator<GapVector<T>>;
+
+ public:
+  GapVector() = default;
+
+  GapVector(std::initializer_list<T> elements) {
+    reserve(elements.size());
+    for (const auto &x : elements) {
+      push_back(x);
+    }
+  }
+
+  GapVector(std::size_t n, const T &value) {
+    reserve(n);
+    for (std::size_t i {0}; i < n; i++) {
+      push_back(value);
+    }
+  }
+
+  /* Element access */
+
+  T& at(std::size_t pos) {
+    if (pos >= size()) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    return (*this)[pos];
+  }
+
+  T& operator[](std::size_t i) {
+    return storage_[i < gap_begin_ ? i : i + GapLength()];
+  }
+
+  const T& operator[](std::size_t i) const {
+    return storage_[i < gap_begin_ ? i : i + GapLength()];
+  }
+
+  /* Iterators */
+
+  Iterator begin() { return Iterator(this, 0); }
+  Iterator end() { return Iterator(this, size()); }
+
+  /* Capacity */
+
+  std::size_t size() const { return storage_.size() - GapLength(); }
+
+  std::size_t capacity() const { return storage_.size(); }
+
+  bool empty() const { return size() == 0; }
+
+  void reserve(std::size_t cap) {
+    if (cap > storage_.size()) {
+      Grow(cap);
+    }
+  }
+
+  /* Cursor. Edits at the cursor are the cheap ones; any edit elsewhere
+     moves the cursor there first. */
+
+  std::size_t cursor() const { return gap_begin_; }
+
+  void move_cursor(std::size_t pos) {
+    if (pos > size()) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    MoveGap(pos);
+  }
+
+  /* Modifiers */
+
+  /* Inserts value before position pos and leaves the cursor after it */
+  void insert(std::size_t pos, const T &value) {
+    insert(pos, T(value));
+  }
+
+  void insert(std::size_t pos, T &&value) {
+    if (pos > size()) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    if (gap_begin_ == gap_end_) {
+      Grow(storage_.size() < kMinCapacity ? kMinCapacity : storage_.size() * 2);
+    }
+    MoveGap(pos);
+    storage_[gap_begin_++] = std::move(value);
+  }
+
+  Iterator insert(Iterator pos, const T &value) {
+    insert(pos.index(), value);
+    return pos;
+  }
+
+  /* Removes the element at pos and leaves the cursor where it was */
+  void erase(std::size_t pos) {
+    erase(pos, pos + 1);
+  }
+
+  /* Removes [first, last) */
+  void erase(std::size_t first, std::size_t last) {
+    if (first > last || last > size()) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    MoveGap(first);
+    for (std::size_t i {0}; i < last - first; i++) {
+      storage_[gap_end_++] = T(); // Slots stay owned by storage_, so reset instead of destroying
+    }
+  }
+
+  Iterator erase(Iterator pos) {
+    erase(pos.index());
+    return pos;
+  }
+
+  void push_back(const T &value) { insert(size(), value); }
+
+  void push_back(T &&value) { insert(size(), std::move(value)); }
+
+  void pop_back() { erase(size() - 1); }
+
+  void clear() {
+    for (std::size_t i {0}; i < storage_.size(); i++) {
+      storage_[i] = T();
+    }
+    gap_begin_ = 0;
+    gap_end_ = storage_.size();
+  }
+
+ private:
+  static constexpr std::size_t kMinCapacity = 16;
+
+  std::size_t GapLength() const { return gap_end_ - gap_begin_; }
+
+  /* Shifts the elements between the gap and pos across it, so the gap
+     starts at pos */
+  void MoveGap(std::size_t pos) {
+    T* data = storage_.data();
+    if (gap_begin_ == gap_end_) { // Nothing to shift, and shifting would self-move
+      gap_begin_ = gap_end_ = pos;
+    } else if (pos < gap_begin_) {
+      std::move_backward(data + pos, data + gap_begin_, data + gap_end_);
+      gap_end_ -= gap_begin_ - pos;
+      gap_begin_ = pos;
+    } else if (pos > gap_begin_) {
+      std::size_t count = pos - gap_begin_;
+      std::move(data + gap_end_, data + gap_end_ + count, data + gap_begin_);
+      gap_begin_ += count;
+      gap_end_ += count;
+    }
+  }
+
+  /* Reallocates to cap slots, widening the gap where it is */
+  void Grow(std::size_t cap) {
+    MyVector<T> bigger;
+    bigger.resize(cap);
+    std::size_t tail = storage_.size() - gap_end_;
+    std::move(storage_.data(), storage_.data() + gap_begin_, bigger.data());
+    std::move(storage_.data() + gap_end_, storage_.data() + storage_.size(), bigger.data() + cap - tail);
+    gap_end_ = cap - tail;
+    storage_ = std::move(bigger);
+  }
+
+  MyVector<T> storage_; // Every slot, gap included
+  std::size_t gap_begin_ = 0;
+  std::size_t gap_end_ = 0;
+};
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef MY_INDEX_ITERATOR_H
+#define MY_INDEX_ITERATOR_H
+
+#include <cstddef>
+
+namespace my {
+
+/* Iterator for containers whose elements are not contiguous but have O(1)
+   operator[]: it is a position, and dereferencing asks the container. Has
+   the same operations as MyVectorIterator. */
+template <typename Container>
+class IndexIterator {
+ public:
+  using ValueType = typename Container::ValueType;
+  using PointerType = ValueType*;
+  using ReferenceType = ValueType&;
+
+ public:
+  IndexIterator(Container* container, std::size_t index) : container_(container), index_(index) {}
+
+  IndexIterator& operator++() {
+    index_++;
+    return *this;
+  }
+
+  IndexIterator operator++(int) {
+    IndexIterator tmp = *this;
+    index_++;
+    return tmp;
+  }
+
+  IndexIterator& operator--() {
+    index_--;
+    return *this;
+  }
+
+  IndexIterator operator--(int) {
+    IndexIterator tmp = *this;
+    index_--;
+    return tmp;
+  }
+
+  ReferenceType operator[](int i) const { return (*container_)[index_ + i]; }
+
+  PointerType operator->() const { return &(*container_)[index_]; }
+
+  ReferenceType operator*() const { return (*container_)[index_]; }
+
+  bool operator==(const IndexIterator &rhs) const {
+    return container_ == rhs.container_ && index_ == rhs.index_;
+  }
+
+  bool operator!=(const IndexIterator &rhs) const {
+    return !(*this == rhs);
+  }
+
+  IndexIterator operator+(int i) const { return IndexIterator(container_, index_ + i); }
+
+  IndexIterator operator-(int i) const { return IndexIterator(container_, index_ - i); }
+
+  std::ptrdiff_t operator-(const IndexIterator &rhs) const {
+    return std::ptrdiff_t(index_) - std::ptrdiff_t(rhs.index_);
+  }
+
+  /* Position in the container */
+  std::size_t index() const { return index_; }
+
+ private:
+  Container* container_;
+  std::size_t index_;
+};
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,212 @@
+/*
+   Tiered vector: O(sqrt n) inserts and erases anywhere, O(1) indexing
+*/
+
+#ifndef MY_TIERED_VECTOR_H
+#define MY_TIERED_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "../MyVector/MyVector.h"
+#include "IndexIterator.h"
+
+namespace my {
+
+/* Elements are split into blocks of B slots, each a circular buffer with
+   its own head, all full except the last. Every block lives in one MyVector,
+   block j at slots [j * B, (j + 1) * B). An insert shifts within its own
+   block (O(B)) and then every later block hands its last element on to the
+   next one by moving a head, O(1) per block; erase runs the other way. B is
+   a power of two kept near sqrt(n), so both parts cost O(sqrt n), and
+   operator[] is a shift, a mask and one head lookup. */
+template <typename T>
+class TieredVector {
+ public:
+  using ValueType = T;
+  using PointerType = ValueType*;
+  using ReferenceType = ValueType&;
+  using Iterator = IndexIterator<TieredVector<T>>;
+
+ public:
+  TieredVector() = default;
+
+  TieredVector(std::initializer_list<T> elements) {
+    for (const auto &x : elements) {
+      push_back(x);
+    }
+  }
+
+  TieredVector(std::size_t n, const T &value) {
+    for (std::size_t i {0}; i < n; i++) {
+      push_back(value);
+    }
+  }
+
+  /* Element access */
+
+  T& at(std::size_t pos) {
+    if (pos >= size_) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    return (*this)[pos];
+  }
+
+  T& operator[](std::size_t i) { return storage_[Slot(i)]; }
+
+  const T& operator[](std::size_t i) const { return storage_[Slot(i)]; }
+
+  /* Iterators */
+
+  Iterator begin() { return Iterator(this, 0); }
+  Iterator end() { return Iterator(this, size_); }
+
+  /* Capacity */
+
+  std::size_t size() const { return size_; }
+
+  std::size_t capacity() const { return storage_.size(); }
+
+  bool empty() const { return size_ == 0; }
+
+  /* Number of slots per block */
+  std::size_t block_size() const { return std::size_t(1) << shift_; }
+
+  /* Modifiers */
+
+  void insert(std::size_t pos, const T &value) {
+    insert(pos, T(value));
+  }
+
+  void insert(std::size_t pos, T &&value) {
+    if (pos > size_) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    if (size_ + 1 > 4 * block_size() * block_size()) {
+      Rebuild(shift_ + 1);
+    }
+    std::size_t mask = block_size() - 1;
+    std::size_t last = size_ >> shift_; // Block that gains a slot
+    EnsureBlocks(last + 1);
+
+    // Each block after pos's hands its last element to the next one's front
+    std::size_t k = pos >> shift_;
+    for (std::size_t j {last}; j > k; j--) {
+      heads_[j] = (heads_[j] - 1) & mask;
+      storage_[Base(j) + heads_[j]] = std::move(storage_[Base(j - 1) + ((heads_[j - 1] + mask) & mask)]);
+    }
+
+    // Block k now has a free slot at its back; open one at pos instead
+    std::size_t count = k < last ? mask : size_ & mask;
+    for (std::size_t o {count}; o > (pos & mask); o--) {
+      storage_[Base(k) + ((heads_[k] + o) & mask)] = std::move(storage_[Base(k) + ((heads_[k] + o - 1) & mask)]);
+    }
+    storage_[Base(k) + ((heads_[k] + pos) & mask)] = std::move(value);
+    size_++;
+  }
+
+  Iterator insert(Iterator pos, const T &value) {
+    insert(pos.index(), value);
+    return pos;
+  }
+
+  void erase(std::size_t pos) {
+    if (pos >= size_) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    std::size_t mask = block_size() - 1;
+    std::size_t last = (size_ - 1) >> shift_;
+    std::size_t k = pos >> shift_;
+
+    // Close the hole at pos, leaving block k's back slot free
+    std::size_t count = k < last ? block_size() : size_ - (last << shift_);
+    for (std::size_t o {pos & mask}; o + 1 < count; o++) {
+      storage_[Base(k) + ((heads_[k] + o) & mask)] = std::move(storage_[Base(k) + ((heads_[k] + o + 1) & mask)]);
+    }
+
+    // Each later block hands its first element back to the previous one
+    for (std::size_t j {k + 1}; j <= last; j++) {
+      storage_[Base(j - 1) + ((heads_[j - 1] + mask) & mask)] = std::move(storage_[Base(j) + heads_[j]]);
+      heads_[j] = (heads_[j] + 1) & mask;
+    }
+
+    // The slot given up is the back of block k, or the old front of the
+    // last block when elements were handed back. Slots stay owned by
+    // storage_, so reset it instead of destroying.
+    std::size_t freed = k < last ? (heads_[last] + mask) & mask : (heads_[k] + count - 1) & mask;
+    storage_[Base(last) + freed] = T();
+    size_--;
+
+    if (shift_ > kMinShift && size_ < block_size() * block_size() / 4) {
+      Rebuild(shift_ - 1);
+    }
+  }
+
+  Iterator erase(Iterator pos) {
+    erase(pos.index());
+    return pos;
+  }
+
+  void push_back(const T &value) { insert(size_, value); }
+
+  void push_back(T &&value) { insert(size_, std::move(value)); }
+
+  void pop_back() { erase(size_ - 1); }
+
+  void clear() {
+    storage_ = MyVector<T>();
+    heads_ = MyVector<std::size_t>();
+    size_ = 0;
+    shift_ = kMinShift;
+  }
+
+ private:
+  static constexpr std::size_t kMinShift = 4;
+
+  std::size_t Base(std::size_t block) const { return block << shift_; }
+
+  std::size_t Slot(std::size_t i) const {
+    std::size_t block = i >> shift_;
+    return Base(block) + ((heads_[block] + i) & (block_size() - 1));
+  }
+
+  /* Makes sure blocks [0, n) have storage, growing geometrically */
+  void EnsureBlocks(std::size_t n) {
+    std::size_t blocks = heads_.size();
+    if (n <= blocks) {
+      return;
+    }
+    std::size_t grown = n > 2 * blocks ? n : 2 * blocks;
+    MyVector<T> bigger;
+    bigger.resize(grown << shift_);
+    std::move(storage_.data(), storage_.data() + storage_.size(), bigger.data());
+    storage_ = std::move(bigger);
+    heads_.resize(grown, 0);
+  }
+
+  /* Lays the elements out again with blocks of 2^shift slots */
+  void Rebuild(std::size_t shift) {
+    std::size_t blocks = ((size_ >> shift) + 1) * 2;
+    MyVector<T> fresh;
+    fresh.resize(blocks << shift);
+    for (std::size_t i {0}; i < size_; i++) {
+      fresh[i] = std::move((*this)[i]);
+    }
+    storage_ = std::move(fresh);
+    heads_ = MyVector<std::size_t>();
+    heads_.resize(blocks, 0);
+    shift_ = shift;
+  }
+
+  MyVector<T> storage_;
+  MyVector<std::size_t> heads_; // Offset of each block's first element
+  std::size_t size_ = 0;
+  std::size_t shift_ = kMinShift; // log2 of the block size
+};
+
+} // Namespace bracket
+
+#endif
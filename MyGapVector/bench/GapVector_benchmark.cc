@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "../GapVector.h"
+#include "../TieredVector.h"
+
+// One insert plus one erase per iteration on a container holding n ints,
+// at a uniformly random position or within 16 of a slowly drifting cursor.
+// MyVector pays O(n) for both, GapVector O(1) near its cursor and O(n)
+// anywhere else, TieredVector O(sqrt n) everywhere.
+
+static std::size_t RandomPos(std::mt19937_64 &rng, std::size_t, std::size_t n) {
+  return rng() % n;
+}
+
+static std::size_t LocalPos(std::mt19937_64 &rng, std::size_t step, std::size_t n) {
+  std::size_t cursor = (n / 4 + step / 64) % (n - 32);
+  return cursor + rng() % 16;
+}
+
+template <typename Container>
+static void Fill(Container &c, std::size_t n) {
+  for (std::size_t i {0}; i < n; i++) {
+    c.push_back(int(i));
+  }
+}
+
+static void Insert(MyVector<int> &v, std::size_t pos, int x) { v.insert(v.begin() + int(pos), x); }
+static void Erase(MyVector<int> &v, std::size_t pos) { v.erase(v.begin() + int(pos)); }
+
+template <typename Container>
+static void Insert(Container &c, std::size_t pos, int x) { c.insert(pos, x); }
+template <typename Container>
+static void Erase(Container &c, std::size_t pos) { c.erase(pos); }
+
+template <typename Container, std::size_t (*Position)(std::mt19937_64 &, std::size_t, std::size_t)>
+static void BM_Edit(benchmark::State &state) {
+  std::size_t n = state.range(0);
+  Container c;
+  Fill(c, n);
+  std::mt19937_64 rng(42);
+  std::size_t step {0};
+  for (auto _ : state) {
+    Insert(c, Position(rng, step, n), int(step));
+    Erase(c, Position(rng, step, n));
+    step++;
+  }
+  benchmark::DoNotOptimize(c[0]);
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+
+BENCHMARK_TEMPLATE(BM_Edit, MyVector<int>, RandomPos)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Edit, my::GapVector<int>, RandomPos)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Edit, my::TieredVector<int>, RandomPos)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK_TEMPLATE(BM_Edit, MyVector<int>, LocalPos)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Edit, my::GapVector<int>, LocalPos)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Edit, my::TieredVector<int>, LocalPos)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK_MAIN();
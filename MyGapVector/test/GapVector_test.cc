@@ -0,0 +1,83 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../GapVector.h"
+
+using my::GapVector;
+
+TEST(GapVectorTest, InitializerListAndIndexing) {
+  GapVector<int> gv {1, 2, 3, 4};
+  EXPECT_EQ(gv.size(), 4);
+  EXPECT_EQ(gv[0], 1);
+  EXPECT_EQ(gv.at(3), 4);
+  EXPECT_THROW(gv.at(4), std::out_of_range);
+}
+
+TEST(GapVectorTest, EditsAtCursor) {
+  GapVector<char> gv;
+  for (char c : std::string("helloworld")) {
+    gv.push_back(c);
+  }
+  gv.insert(5, ' ');
+  EXPECT_EQ(gv.cursor(), 6);
+  gv.insert(6, 'W');
+  gv.erase(7);
+  std::string s;
+  for (char c : gv) {
+    s += c;
+  }
+  EXPECT_EQ(s, "hello World");
+}
+
+TEST(GapVectorTest, MoveCursor) {
+  GapVector<int> gv {1, 2, 3, 4, 5};
+  gv.move_cursor(2);
+  EXPECT_EQ(gv.cursor(), 2);
+  for (int i {0}; i < 5; i++) {
+    EXPECT_EQ(gv[i], i + 1);
+  }
+  EXPECT_THROW(gv.move_cursor(6), std::out_of_range);
+}
+
+TEST(GapVectorTest, RandomEditsMatchStdVector) {
+  GapVector<std::string> gv;
+  std::vector<std::string> ref;
+  std::mt19937 rng(11);
+  for (int i {0}; i < 5000; i++) {
+    if (!ref.empty() && rng() % 3 == 0) {
+      std::size_t pos = rng() % ref.size();
+      gv.erase(pos);
+      ref.erase(ref.begin() + pos);
+    } else {
+      std::size_t pos = rng() % (ref.size() + 1);
+      gv.insert(pos, std::to_string(i));
+      ref.insert(ref.begin() + pos, std::to_string(i));
+    }
+  }
+  ASSERT_EQ(gv.size(), ref.size());
+  for (std::size_t i {0}; i < ref.size(); i++) {
+    ASSERT_EQ(gv[i], ref[i]);
+  }
+}
+
+TEST(GapVectorTest, EraseRangeAndPopBack) {
+  GapVector<int> gv {0, 1, 2, 3, 4, 5};
+  gv.erase(1, 4);
+  gv.pop_back();
+  ASSERT_EQ(gv.size(), 2);
+  EXPECT_EQ(gv[0], 0);
+  EXPECT_EQ(gv[1], 4);
+}
+
+TEST(GapVectorTest, IteratorInsertAndClear) {
+  GapVector<int> gv {1, 3};
+  auto it = gv.insert(gv.begin() + 1, 2);
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(gv.end() - gv.begin(), 3);
+  gv.clear();
+  EXPECT_TRUE(gv.empty());
+  gv.push_back(7);
+  EXPECT_EQ(gv[0], 7);
+}
@@ -0,0 +1,115 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../TieredVector.h"
+
+using my::TieredVector;
+
+template <typename T>
+void ExpectSame(const TieredVector<T> &tv, const std::vector<T> &ref) {
+  ASSERT_EQ(tv.size(), ref.size());
+  for (std::size_t i {0}; i < ref.size(); i++) {
+    ASSERT_EQ(tv[i], ref[i]) << "index " << i;
+  }
+}
+
+TEST(TieredVectorTest, IndexingAcrossBlocks) {
+  TieredVector<int> tv (40, 0);
+  for (int i {0}; i < 40; i++) {
+    tv[i] = i;
+  }
+  EXPECT_EQ(tv.block_size(), 16);
+  EXPECT_EQ(tv[15], 15); // Last slot of block 0
+  EXPECT_EQ(tv[16], 16); // First slot of block 1
+  EXPECT_EQ(tv.at(39), 39);
+  EXPECT_THROW(tv.at(40), std::out_of_range);
+}
+
+TEST(TieredVectorTest, InsertAndEraseAtBlockBoundaries) {
+  TieredVector<std::string> tv;
+  std::vector<std::string> ref;
+  for (int i {0}; i < 100; i++) {
+    tv.push_back(std::to_string(i));
+    ref.push_back(std::to_string(i));
+  }
+  // Each insert shifts one block and hands an element on through the rest
+  for (std::size_t pos : {0, 15, 16, 17, 31, 32, 64, 95, 96}) {
+    tv.insert(pos, "x" + std::to_string(pos));
+    ref.insert(ref.begin() + pos, "x" + std::to_string(pos));
+    ExpectSame(tv, ref);
+  }
+  tv.insert(tv.size(), "end"); // Opens a new block
+  ref.push_back("end");
+  ExpectSame(tv, ref);
+  for (std::size_t pos : {0, 15, 16, 47, 48, 100}) {
+    tv.erase(pos);
+    ref.erase(ref.begin() + pos);
+    ExpectSame(tv, ref);
+  }
+}
+
+TEST(TieredVectorTest, FrontInsertsWrapEveryBlockHead) {
+  TieredVector<int> tv;
+  std::vector<int> ref;
+  for (int i {0}; i < 200; i++) { // Rotates every block's head past slot 0
+    tv.insert(0, i);
+    ref.insert(ref.begin(), i);
+  }
+  ExpectSame(tv, ref);
+  for (int i {0}; i < 150; i++) {
+    tv.erase(0);
+    ref.erase(ref.begin());
+  }
+  ExpectSame(tv, ref);
+}
+
+TEST(TieredVectorTest, IndexingAfterGrowthRebuild) {
+  TieredVector<int> tv;
+  std::vector<int> ref;
+  for (int i {0}; i < 1024; i++) { // 4 * 16 * 16: the most 16 slot blocks hold
+    tv.insert(tv.size() / 3, i);
+    ref.insert(ref.begin() + ref.size() / 3, i);
+  }
+  EXPECT_EQ(tv.block_size(), 16);
+  tv.insert(500, -1); // Rebuilds with 32 slot blocks, heads reset
+  ref.insert(ref.begin() + 500, -1);
+  EXPECT_EQ(tv.block_size(), 32);
+  ExpectSame(tv, ref);
+  for (int i {0}; i < 100; i++) {
+    tv.insert(i * 7, i);
+    ref.insert(ref.begin() + i * 7, i);
+  }
+  ExpectSame(tv, ref);
+}
+
+TEST(TieredVectorTest, BlockSizeTracksSqrtN) {
+  TieredVector<int> tv;
+  for (int i {0}; i < 30000; i++) {
+    tv.insert(tv.size() / 2, i);
+  }
+  EXPECT_GE(tv.block_size() * tv.block_size() * 4, tv.size());
+  EXPECT_LE(tv.block_size(), 512);
+  while (tv.size() > 10) {
+    tv.erase(tv.size() / 3);
+  }
+  EXPECT_EQ(tv.block_size(), 16);
+}
+
+TEST(TieredVectorTest, PopBack) {
+  TieredVector<int> tv {0, 1, 2};
+  tv.pop_back();
+  ASSERT_EQ(tv.size(), 2);
+  EXPECT_EQ(tv[1], 1);
+}
+
+TEST(TieredVectorTest, IteratorInsertAndClear) {
+  TieredVector<int> tv {1, 3};
+  auto it = tv.insert(tv.begin() + 1, 2);
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(tv.end() - tv.begin(), 3);
+  tv.clear();
+  EXPECT_TRUE(tv.empty());
+  tv.push_back(7);
+  EXPECT_EQ(tv[0], 7);
+}
@@ -0,0 +1,201 @@
+/*
+   Chunked loading of record and text files through my::Generator
+*/
+
+#ifndef MY_CHUNK_LOADER_H
+#define MY_CHUNK_LOADER_H
+
+#include <cerrno>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../MyVector/MyVector.h"
+#include "../MyVectorView/VectorView.h"
+#include "Generator.h"
+
+namespace my {
+
+namespace detail {
+
+/* Read only file descriptor, closed on destruction */
+class InputFile {
+ public:
+  explicit InputFile(const std::string &path) : fd_(::open(path.c_str(), O_RDONLY | O_CLOEXEC)) {
+    if (fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), "Could not open " + path);
+    }
+  }
+
+  InputFile(const InputFile &) = delete;
+  InputFile &operator=(const InputFile &) = delete;
+
+  ~InputFile() { ::close(fd_); }
+
+  /* Reads until n bytes are in or the file ends; returns the count */
+  std::size_t ReadFull(void* dst, std::size_t n) {
+    char* out = static_cast<char*>(dst);
+    std::size_t got {0};
+    while (got < n) {
+      ssize_t r = ::read(fd_, out + got, n - got);
+      if (r < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(), "Read failed");
+      }
+      if (r == 0) {
+        break;
+      }
+      got += static_cast<std::size_t>(r);
+    }
+    return got;
+  }
+
+ private:
+  int fd_;
+};
+
+/* Reads the next n bytes into dst, on another thread when Async so it
+   overlaps with whatever the consumer does with the previous chunk */
+template <bool Async>
+std::future<std::size_t> ReadAhead(InputFile &file, void* dst, std::size_t n) {
+  return std::async(Async ? std::launch::async : std::launch::deferred,
+                    [&file, dst, n]() { return file.ReadFull(dst, n); });
+}
+
+/* Binary records, chunk_records at a time. With Async the buffers are
+   double buffered: the read of chunk i + 1 runs while chunk i is out with
+   the consumer. */
+template <typename T, bool Async>
+Generator<VectorView<const T>> ReadRecords(std::string path, std::size_t chunk_records) {
+  static_assert(std::is_trivially_copyable<T>::value, "Records are read as raw bytes");
+  if (chunk_records == 0) {
+    throw std::invalid_argument("chunk_records must be positive");
+  }
+  InputFile file(path);
+  std::size_t bytes = chunk_records * sizeof(T);
+  MyVector<T> buffers[2];
+  buffers[0].resize(chunk_records);
+  if (Async) {
+    buffers[1].resize(chunk_records);
+  }
+  std::size_t current {0};
+  std::size_t got = file.ReadFull(buffers[0].data(), bytes);
+  while (got > 0) {
+    if (got % sizeof(T) != 0) {
+      throw std::runtime_error(path + " ends in the middle of a record");
+    }
+    std::size_t next = Async ? current ^ 1 : current;
+    std::future<std::size_t> ahead;
+    if (Async) {
+      ahead = ReadAhead<Async>(file, buffers[next].data(), bytes);
+    }
+    co_yield VectorView<const T>(buffers[current].data(), got / sizeof(T));
+    got = Async ? ahead.get() : file.ReadFull(buffers[next].data(), bytes);
+    current = next;
+  }
+}
+
+/* Newline delimited text, chunk_bytes at a time, each line passed through
+   parse. A line cut by the chunk border is carried over to the next chunk;
+   the last line needs no trailing newline. */
+template <typename T, bool Async, typename Parse>
+Generator<VectorView<const T>> ReadLines(std::string path, std::size_t chunk_bytes, Parse parse) {
+  if (chunk_bytes == 0) {
+    throw std::invalid_argument("chunk_bytes must be positive");
+  }
+  InputFile file(path);
+  MyVector<char> buffers[2];
+  buffers[0].resize(chunk_bytes);
+  if (Async) {
+    buffers[1].resize(chunk_bytes);
+  }
+  MyVector<T> records;
+  std::string carry; // Start of a line cut by the previous chunk border
+  std::size_t current {0};
+  std::size_t got = file.ReadFull(buffers[0].data(), chunk_bytes);
+  while (got > 0) {
+    std::size_t next = Async ? current ^ 1 : current;
+    std::future<std::size_t> ahead;
+    if (Async) {
+      ahead = ReadAhead<Async>(file, buffers[next].data(), chunk_bytes);
+    }
+
+    std::string_view text(buffers[current].data(), got);
+    records.clear();
+    std::size_t newline = text.find('\n');
+    if (newline != std::string_view::npos && carry.size() > 0) {
+      carry.append(text.data(), newline);
+      records.push_back(parse(std::string_view(carry)));
+      carry.clear();
+      text.remove_prefix(newline + 1);
+      newline = text.find('\n');
+    }
+    while (newline != std::string_view::npos) {
+      records.push_back(parse(text.substr(0, newline)));
+      text.remove_prefix(newline + 1);
+      newline = text.find('\n');
+    }
+    carry.append(text.data(), text.size());
+
+    if (records.size() > 0) {
+      co_yield VectorView<const T>(records.data(), records.size());
+    }
+    got = Async ? ahead.get() : file.ReadFull(buffers[next].data(), chunk_bytes);
+    current = next;
+  }
+  if (carry.size() > 0) {
+    records.clear();
+    records.push_back(parse(std::string_view(carry)));
+    co_yield VectorView<const T>(records.data(), records.size());
+  }
+}
+
+template <typename Parse>
+using ParsedType = std::decay_t<std::invoke_result_t<Parse&, std::string_view>>;
+
+} // namespace detail
+
+/* Yields a file of raw T records chunk_records at a time from one reused
+   buffer, so memory stays at one chunk however large the file is. Each
+   view is valid until the next chunk is requested. */
+template <typename T>
+Generator<VectorView<const T>> read_records(const std::string &path, std::size_t chunk_records) {
+  return detail::ReadRecords<T, false>(path, chunk_records);
+}
+
+/* read_records that reads the next chunk on a second thread while the
+   current one is being consumed; memory is two chunks */
+template <typename T>
+Generator<VectorView<const T>> read_records_async(const std::string &path, std::size_t chunk_records) {
+  return detail::ReadRecords<T, true>(path, chunk_records);
+}
+
+/* Yields parse(line) for every line of a text file, one chunk of
+   chunk_bytes of input at a time */
+template <typename Parse>
+Generator<VectorView<const detail::ParsedType<Parse>>> read_lines(
+    const std::string &path, Parse parse, std::size_t chunk_bytes = std::size_t(1) << 20) {
+  return detail::ReadLines<detail::ParsedType<Parse>, false>(path, chunk_bytes, std::move(parse));
+}
+
+/* read_lines that reads the next chunk of text on a second thread while
+   the current one is being parsed and consumed */
+template <typename Parse>
+Generator<VectorView<const detail::ParsedType<Parse>>> read_lines_async(
+    const std::string &path, Parse parse, std::size_t chunk_bytes = std::size_t(1) << 20) {
+  return detail::ReadLines<detail::ParsedType<Parse>, true>(path, chunk_bytes, std::move(parse));
+}
+
+} // Namespace bracket
+
+#endif
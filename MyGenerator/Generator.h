@@ -0,0 +1,122 @@
+/*
+   Lazy C++20 coroutine generator
+*/
+
+#ifndef MY_GENERATOR_H
+#define MY_GENERATOR_H
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace my {
+
+/* A coroutine returning Generator<T> runs only as far as its next co_yield
+   each time the consumer advances, so values are produced on demand. A
+   yielded value is only valid until the consumer advances again. An
+   exception thrown by the coroutine comes out of begin() or operator++. */
+template <typename T>
+class Generator {
+ public:
+  using ValueType = std::remove_cv_t<std::remove_reference_t<T>>;
+  using ReferenceType = const ValueType&;
+
+  struct promise_type {
+    const ValueType* current = nullptr;
+    std::exception_ptr error;
+
+    Generator get_return_object() {
+      return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+
+    /* The yielded object lives in the coroutine frame until it resumes */
+    std::suspend_always yield_value(const ValueType &value) noexcept {
+      current = std::addressof(value);
+      return {};
+    }
+
+    void return_void() noexcept {}
+
+    void unhandled_exception() { error = std::current_exception(); }
+
+    template <typename U>
+    std::suspend_never await_transform(U &&) = delete; // Generators cannot co_await
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  /* Input iterator; reaching end() means the coroutine has finished */
+  class Iterator {
+   public:
+    explicit Iterator(Handle handle) : handle_(handle) {}
+
+    Iterator& operator++() {
+      Advance(handle_);
+      return *this;
+    }
+
+    ReferenceType operator*() const { return *handle_.promise().current; }
+
+    const ValueType* operator->() const { return handle_.promise().current; }
+
+    bool operator==(std::default_sentinel_t) const { return !handle_ || handle_.done(); }
+
+    bool operator!=(std::default_sentinel_t s) const { return !(*this == s); }
+
+   private:
+    Handle handle_;
+  };
+
+ public:
+  Generator(Generator &&rhs) noexcept : handle_(std::exchange(rhs.handle_, nullptr)) {}
+
+  Generator &operator=(Generator &&rhs) noexcept {
+    if (this != &rhs) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(rhs.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  Generator(const Generator &) = delete;
+  Generator &operator=(const Generator &) = delete;
+
+  ~Generator() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  /* Runs the coroutine to its first co_yield */
+  Iterator begin() {
+    if (handle_) {
+      Advance(handle_);
+    }
+    return Iterator(handle_);
+  }
+
+  std::default_sentinel_t end() const { return std::default_sentinel; }
+
+ private:
+  explicit Generator(Handle handle) : handle_(handle) {}
+
+  static void Advance(Handle handle) {
+    handle.resume();
+    if (handle.promise().error) {
+      std::rethrow_exception(std::exchange(handle.promise().error, nullptr));
+    }
+  }
+
+  Handle handle_;
+};
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <benchmark/benchmark.h>
+#include "../ChunkLoader.h"
+
+// Loading a 64 MiB file of uint64_t records, either whole into one
+// MyVector or through the chunked generators, with a consumer that does a
+// little work per record. FirstRecord times only the wait for the first
+// chunk.
+
+static const char* kPath = "/tmp/chunk_loader_benchmark.bin";
+static constexpr std::size_t kRecords = std::size_t(8) << 20;
+static constexpr std::size_t kChunk = std::size_t(64) << 10;
+
+static void MakeFile() {
+  static bool made = false;
+  if (made) {
+    return;
+  }
+  std::ofstream out(kPath, std::ios::binary);
+  for (std::uint64_t i {0}; i < kRecords; i++) {
+    out.write(reinterpret_cast<const char*>(&i), sizeof(i));
+  }
+  made = true;
+}
+
+static std::uint64_t Consume(my::VectorView<const std::uint64_t> records) {
+  std::uint64_t h {0};
+  for (std::size_t i {0}; i < records.size(); i++) {
+    h = (h ^ records[i]) * 0x9E3779B97F4A7C15ull;
+  }
+  return h;
+}
+
+static void BM_WholeFile(benchmark::State &state) {
+  MakeFile();
+  for (auto _ : state) {
+    MyVector<std::uint64_t> all;
+    all.resize(kRecords);
+    my::detail::InputFile file(kPath);
+    file.ReadFull(all.data(), kRecords * sizeof(std::uint64_t));
+    benchmark::DoNotOptimize(Consume(my::VectorView<const std::uint64_t>(all)));
+  }
+  state.SetBytesProcessed(state.iterations() * kRecords * sizeof(std::uint64_t));
+}
+
+template <bool Async>
+static void BM_Chunked(benchmark::State &state) {
+  MakeFile();
+  for (auto _ : state) {
+    std::uint64_t h {0};
+    auto gen = Async ? my::read_records_async<std::uint64_t>(kPath, kChunk)
+                     : my::read_records<std::uint64_t>(kPath, kChunk);
+    for (auto chunk : gen) {
+      h ^= Consume(chunk);
+    }
+    benchmark::DoNotOptimize(h);
+  }
+  state.SetBytesProcessed(state.iterations() * kRecords * sizeof(std::uint64_t));
+}
+
+template <bool Async>
+static void BM_FirstRecord(benchmark::State &state) {
+  MakeFile();
+  for (auto _ : state) {
+    auto gen = Async ? my::read_records_async<std::uint64_t>(kPath, kChunk)
+                     : my::read_records<std::uint64_t>(kPath, kChunk);
+    benchmark::DoNotOptimize((*gen.begin())[0]);
+  }
+}
+
+BENCHMARK(BM_WholeFile)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Chunked, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Chunked, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_FirstRecord, false)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FirstRecord, true)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,142 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include "../ChunkLoader.h"
+#include "../Generator.h"
+
+using my::Generator;
+
+Generator<int> Iota(int n) {
+  for (int i {0}; i < n; i++) {
+    co_yield i;
+  }
+}
+
+Generator<int> ThrowsAfter(int n) {
+  for (int i {0}; i < n; i++) {
+    co_yield i;
+  }
+  throw std::runtime_error("done");
+}
+
+TEST(GeneratorTest, YieldsLazily) {
+  std::vector<int> seen;
+  for (int x : Iota(5)) {
+    seen.push_back(x);
+  }
+  EXPECT_EQ(seen, std::vector<int>({0, 1, 2, 3, 4}));
+}
+
+TEST(GeneratorTest, EmptyAndEarlyExit) {
+  for (int x : Iota(0)) {
+    FAIL() << x;
+  }
+  Generator<int> gen = Iota(1000000);
+  auto it = gen.begin();
+  ++it;
+  EXPECT_EQ(*it, 1); // Destroying gen mid-way is fine
+}
+
+TEST(GeneratorTest, ExceptionsReachTheConsumer) {
+  int count {0};
+  EXPECT_THROW({
+    for (int x : ThrowsAfter(3)) {
+      count += x;
+    }
+  }, std::runtime_error);
+  EXPECT_EQ(count, 3);
+}
+
+class ChunkLoaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char name[] = "/tmp/chunk_loader_XXXXXX";
+    int fd = mkstemp(name);
+    ::close(fd);
+    path_ = name;
+  }
+
+  void TearDown() override {
+    std::remove(path_.c_str());
+  }
+
+  void Write(const void* data, std::size_t n) {
+    std::ofstream out(path_, std::ios::binary);
+    out.write(static_cast<const char*>(data), n);
+  }
+
+  std::string path_;
+};
+
+TEST_F(ChunkLoaderTest, BinaryRecords) {
+  std::vector<std::uint64_t> values(1000);
+  for (std::size_t i {0}; i < values.size(); i++) {
+    values[i] = i * i;
+  }
+  Write(values.data(), values.size() * sizeof(std::uint64_t));
+  for (bool async : {false, true}) {
+    std::vector<std::uint64_t> loaded;
+    std::size_t chunks {0};
+    auto gen = async ? my::read_records_async<std::uint64_t>(path_, 64)
+                     : my::read_records<std::uint64_t>(path_, 64);
+    for (auto chunk : gen) {
+      EXPECT_LE(chunk.size(), 64);
+      loaded.insert(loaded.end(), chunk.begin(), chunk.end());
+      chunks++;
+    }
+    EXPECT_EQ(loaded, values);
+    EXPECT_EQ(chunks, 16);
+  }
+}
+
+TEST_F(ChunkLoaderTest, TruncatedRecordThrows) {
+  char bytes[12] = {};
+  Write(bytes, sizeof(bytes));
+  auto gen = my::read_records<std::uint64_t>(path_, 4);
+  EXPECT_THROW(gen.begin(), std::runtime_error);
+}
+
+TEST_F(ChunkLoaderTest, MissingFileThrows) {
+  auto gen = my::read_records<int>("/nonexistent/file", 4);
+  EXPECT_THROW(gen.begin(), std::system_error);
+}
+
+TEST_F(ChunkLoaderTest, TextLinesAcrossChunkBorders) {
+  std::string text;
+  for (int i {0}; i < 500; i++) {
+    text += std::to_string(i * 37) + "\n";
+  }
+  text += "12345"; // No trailing newline
+  Write(text.data(), text.size());
+  auto parse = [](std::string_view line) { return std::stoi(std::string(line)); };
+  for (bool async : {false, true}) {
+    std::vector<int> loaded;
+    // 7 byte chunks cut most lines in two
+    auto gen = async ? my::read_lines_async(path_, parse, 7) : my::read_lines(path_, parse, 7);
+    for (auto chunk : gen) {
+      loaded.insert(loaded.end(), chunk.begin(), chunk.end());
+    }
+    ASSERT_EQ(loaded.size(), 501);
+    for (int i {0}; i < 500; i++) {
+      ASSERT_EQ(loaded[i], i * 37);
+    }
+    EXPECT_EQ(loaded[500], 12345);
+  }
+}
+
+TEST_F(ChunkLoaderTest, LongerLineThanChunk) {
+  std::string text = std::string(100, 'a') + "\nb\n";
+  Write(text.data(), text.size());
+  std::vector<std::size_t> lengths;
+  for (auto chunk : my::read_lines(path_, [](std::string_view line) { return line.size(); }, 8)) {
+    lengths.insert(lengths.end(), chunk.begin(), chunk.end());
+  }
+  EXPECT_EQ(lengths, std::vector<std::size_t>({100, 1}));
+}
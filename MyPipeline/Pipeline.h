@@ -0,0 +1,358 @@
+/*
+   Lazy, fused range pipelines over MyVector and VectorView
+*/
+
+#ifndef MY_PIPELINE_H
+#define MY_PIPELINE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../MyVector/MyVector.h"
+#include "../MyVectorView/VectorView.h"
+
+namespace my {
+
+/* Every stage is push based: Run(sink) feeds each element to sink, which
+   returns false to stop early, and Run itself returns false if it stopped
+   before its input ran out. Adaptors wrap the sink of the next stage in a
+   lambda, so once inlined a whole pipeline is one loop over the source with
+   no intermediate buffers. SizeHint() is the exact number of elements the
+   stage will produce, or kUnknownSize when a filter makes that impossible
+   to know up front. */
+
+inline constexpr std::size_t kUnknownSize = static_cast<std::size_t>(-1);
+
+namespace detail {
+
+/* Element type used when a pipeline is collected. Strips references, also
+   inside the pairs produced by enumerate and zip. */
+template <typename T>
+struct Stored {
+  using Type = std::decay_t<T>;
+};
+
+template <typename A, typename B>
+struct Stored<std::pair<A, B>> {
+  using Type = std::pair<typename Stored<A>::Type, typename Stored<B>::Type>;
+};
+
+template <typename T>
+struct RangeStage {
+  using ValueType = T&;
+
+  template <typename Sink>
+  bool Run(Sink &sink) {
+    for (std::size_t i {0}; i < view.size(); i++) {
+      if (!sink(view[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::size_t SizeHint() const { return view.size(); }
+
+  VectorView<T> view;
+};
+
+template <typename Source, typename Predicate>
+struct FilterStage {
+  using ValueType = typename Source::ValueType;
+
+  template <typename Sink>
+  bool Run(Sink &sink) {
+    auto step = [&](ValueType x) -> bool {
+      if (pred(x)) {
+        return sink(std::forward<ValueType>(x));
+      }
+      return true;
+    };
+    return source.Run(step);
+  }
+
+  std::size_t SizeHint() const { return kUnknownSize; }
+
+  Source source;
+  Predicate pred;
+};
+
+template <typename Source, typename Function>
+struct TransformStage {
+  using ValueType = decltype(std::declval<Function&>()(std::declval<typename Source::ValueType>()));
+
+  template <typename Sink>
+  bool Run(Sink &sink) {
+    auto step = [&](typename Source::ValueType x) -> bool {
+      return sink(fn(std::forward<typename Source::ValueType>(x)));
+    };
+    return source.Run(step);
+  }
+
+  std::size_t SizeHint() const { return source.SizeHint(); }
+
+  Source source;
+  Function fn;
+};
+
+template <typename Source>
+struct TakeStage {
+  using ValueType = typename Source::ValueType;
+
+  template <typename Sink>
+  bool Run(Sink &sink) {
+    if (count == 0) {
+      return false;
+    }
+    std::size_t left = count;
+    auto step = [&](ValueType x) -> bool {
+      return sink(std::forward<ValueType>(x)) && --left != 0;
+    };
+    return source.Run(step);
+  }
+
+  std::size_t SizeHint() const {
+    std::size_t n = source.SizeHint();
+    return n == kUnknownSize ? n : (n < count ? n : count);
+  }
+
+  Source source;
+  std::size_t count;
+};
+
+template <typename Source>
+struct DropStage {
+  using ValueType = typename Source::ValueType;
+
+  template <typename Sink>
+  bool Run(Sink &sink) {
+    std::size_t skip = count;
+    auto step = [&](ValueType x) -> bool {
+      if (skip > 0) {
+        skip--;
+        return true;
+      }
+      return sink(std::forward<ValueType>(x));
+    };
+    return source.Run(step);
+  }
+
+  std::size_t SizeHint() const {
+    std::size_t n = source.SizeHint();
+    return n == kUnknownSize ? n : (n > count ? n - count : 0);
+  }
+
+  Source source;
+  std::size_t count;
+};
+
+/* Gathers elements into a reused buffer and hands out views of it. A view
+   is only valid until the sink returns. */
+template <typename Source>
+struct ChunkStage {
+  using ElementType = typename Stored<typename Source::ValueType>::Type;
+  using ValueType = VectorView<const ElementType>;
+
+  template <typename Sink>
+  bool Run(Sink &sink) {
+    MyVector<ElementType> buffer;
+    buffer.reserve(count);
+    bool stopped = false;
+    auto step = [&](typename Source::ValueType x) -> bool {
+      buffer.push_back(ElementType(std::forward<typename Source::ValueType>(x)));
+      if (buffer.size() < count) {
+        return true;
+      }
+      stopped = !sink(ValueType(buffer));
+      buffer.clear();
+      return !stopped;
+    };
+    bool finished = source.Run(step);
+    if (!stopped && buffer.size() > 0) {
+      return sink(ValueType(buffer)) && finished;
+    }
+    return finished && !stopped;
+  }
+
+  std::size_t SizeHint() const {
+    std::size_t n = source.SizeHint();
+    return n == kUnknownSize ? n : (n + count - 1) / count;
+  }
+
+  Source source;
+  std::size_t count;
+};
+
+template <typename Source>
+struct EnumerateStage {
+  using ValueType = std::pair<std::size_t, typename Source::ValueType>;
+
+  template <typename Sink>
+  bool Run(Sink &sink) {
+    std::size_t index {0};
+    auto step = [&](typename Source::ValueType x) -> bool {
+      return sink(ValueType(index++, std::forward<typename Source::ValueType>(x)));
+    };
+    return source.Run(step);
+  }
+
+  std::size_t SizeHint() const { return source.SizeHint(); }
+
+  Source source;
+};
+
+/* Pairs every element with the element at the same position of a second
+   range and stops at the end of the shorter one */
+template <typename Source, typename U>
+struct ZipStage {
+  using ValueType = std::pair<typename Source::ValueType, U&>;
+
+  template <typename Sink>
+  bool Run(Sink &sink) {
+    std::size_t index {0};
+    if (other.empty()) {
+      return false;
+    }
+    auto step = [&](typename Source::ValueType x) -> bool {
+      if (!sink(ValueType(std::forward<typename Source::ValueType>(x), other[index]))) {
+        return false;
+      }
+      return ++index < other.size();
+    };
+    return source.Run(step);
+  }
+
+  std::size_t SizeHint() const {
+    std::size_t n = source.SizeHint();
+    return n == kUnknownSize ? n : (n < other.size() ? n : other.size());
+  }
+
+  Source source;
+  VectorView<U> other;
+};
+
+} // namespace detail
+
+template <typename Source>
+class Pipeline {
+ public:
+  using ValueType = typename Source::ValueType;
+
+ public:
+  explicit Pipeline(Source source)
+    : source_(std::move(source)) {}
+
+  /* Adaptors */
+
+  template <typename Predicate>
+  Pipeline<detail::FilterStage<Source, Predicate>> filter(Predicate pred) const {
+    return Pipeline<detail::FilterStage<Source, Predicate>>({source_, pred});
+  }
+
+  template <typename Function>
+  Pipeline<detail::TransformStage<Source, Function>> transform(Function fn) const {
+    return Pipeline<detail::TransformStage<Source, Function>>({source_, fn});
+  }
+
+  Pipeline<detail::TakeStage<Source>> take(std::size_t count) const {
+    return Pipeline<detail::TakeStage<Source>>({source_, count});
+  }
+
+  Pipeline<detail::DropStage<Source>> drop(std::size_t count) const {
+    return Pipeline<detail::DropStage<Source>>({source_, count});
+  }
+
+  /* Groups of count elements, the last one possibly shorter */
+  Pipeline<detail::ChunkStage<Source>> chunk(std::size_t count) const {
+    if (count == 0) {
+      throw std::invalid_argument("Chunk size must be positive");
+    }
+    return Pipeline<detail::ChunkStage<Source>>({source_, count});
+  }
+
+  Pipeline<detail::EnumerateStage<Source>> enumerate() const {
+    return Pipeline<detail::EnumerateStage<Source>>({source_});
+  }
+
+  template <typename U>
+  Pipeline<detail::ZipStage<Source, U>> zip(VectorView<U> other) const {
+    return Pipeline<detail::ZipStage<Source, U>>({source_, other});
+  }
+
+  template <typename Container>
+  auto zip(Container &other) const {
+    return zip(VectorView<std::remove_pointer_t<decltype(other.data())>>(other));
+  }
+
+  /* Terminals */
+
+  template <typename Function>
+  void for_each(Function fn) {
+    auto step = [&](ValueType x) -> bool {
+      fn(std::forward<ValueType>(x));
+      return true;
+    };
+    source_.Run(step);
+  }
+
+  /* Runs the pipeline into a new container, reserving up front whenever the
+     final size is known */
+  template <template <typename...> class Container = MyVector>
+  Container<typename detail::Stored<ValueType>::Type> collect() {
+    using Element = typename detail::Stored<ValueType>::Type;
+    Container<Element> out;
+    std::size_t n = source_.SizeHint();
+    if (n != kUnknownSize) {
+      out.reserve(n);
+    }
+    auto step = [&](ValueType x) -> bool {
+      out.push_back(Element(std::forward<ValueType>(x)));
+      return true;
+    };
+    source_.Run(step);
+    return out;
+  }
+
+  std::size_t count() {
+    std::size_t n = source_.SizeHint();
+    if (n != kUnknownSize) {
+      return n;
+    }
+    n = 0;
+    auto step = [&](ValueType) -> bool {
+      n++;
+      return true;
+    };
+    source_.Run(step);
+    return n;
+  }
+
+  std::size_t size_hint() const { return source_.SizeHint(); }
+
+ private:
+  Source source_;
+};
+
+/* Entry points. Call them qualified as my::pipe, the POSIX ::pipe from
+   <unistd.h> otherwise wins for array arguments. */
+
+template <typename T>
+Pipeline<detail::RangeStage<T>> pipe(VectorView<T> view) {
+  return Pipeline<detail::RangeStage<T>>({view});
+}
+
+template <typename T, std::size_t N>
+Pipeline<detail::RangeStage<T>> pipe(T (&array)[N]) {
+  return pipe(VectorView<T>(array));
+}
+
+template <typename Container>
+auto pipe(Container &c) {
+  return pipe(VectorView<std::remove_pointer_t<decltype(c.data())>>(c));
+}
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <benchmark/benchmark.h>
+#include "../Pipeline.h"
+
+// filter -> transform -> take over a MyVector, written once as a lazy
+// my::pipe and once in the materializing style where every stage fills a
+// new MyVector through push_back. Allocations are counted through the
+// global operator new and reported per iteration, and bytes_per_second
+// counts the input scanned.
+
+static std::size_t g_allocations {0};
+static std::size_t g_allocated_bytes {0};
+
+void* operator new(std::size_t n) {
+  g_allocations++;
+  g_allocated_bytes += n;
+  if (void* p = std::malloc(n)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t n) { return operator new(n); }
+
+// Every delete form is replaced to match, and kept out of line: inlined,
+// GCC pairs the free() with the new expression and warns of a mismatch.
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete[](void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static MyVector<std::uint32_t> Input(std::size_t n) {
+  std::mt19937 rng(42);
+  MyVector<std::uint32_t> v;
+  v.reserve(n);
+  for (std::size_t i {0}; i < n; i++) {
+    v.push_back(rng());
+  }
+  return v;
+}
+
+static void Report(benchmark::State &state, std::size_t allocations, std::size_t bytes) {
+  state.counters["allocs"] = benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+  state.counters["alloc_bytes"] = benchmark::Counter(bytes, benchmark::Counter::kAvgIterations);
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(std::uint32_t));
+}
+
+static void BM_Materializing(benchmark::State &state) {
+  MyVector<std::uint32_t> input = Input(state.range(0));
+  std::size_t take = state.range(0) / 4;
+  std::size_t allocations = g_allocations;
+  std::size_t bytes = g_allocated_bytes;
+  for (auto _ : state) {
+    MyVector<std::uint32_t> filtered;
+    for (std::size_t i {0}; i < input.size(); i++) {
+      if (input[i] % 3 != 0) {
+        filtered.push_back(input[i]);
+      }
+    }
+    MyVector<std::uint64_t> mapped;
+    for (std::size_t i {0}; i < filtered.size(); i++) {
+      mapped.push_back(std::uint64_t(filtered[i]) * 7 + 1);
+    }
+    MyVector<std::uint64_t> taken;
+    for (std::size_t i {0}; i < mapped.size() && i < take; i++) {
+      taken.push_back(mapped[i]);
+    }
+    benchmark::DoNotOptimize(taken.data());
+  }
+  Report(state, g_allocations - allocations, g_allocated_bytes - bytes);
+}
+
+static void BM_Pipeline(benchmark::State &state) {
+  MyVector<std::uint32_t> input = Input(state.range(0));
+  std::size_t take = state.range(0) / 4;
+  std::size_t allocations = g_allocations;
+  std::size_t bytes = g_allocated_bytes;
+  for (auto _ : state) {
+    auto taken = my::pipe(input)
+      .filter([](std::uint32_t x) { return x % 3 != 0; })
+      .transform([](std::uint32_t x) { return std::uint64_t(x) * 7 + 1; })
+      .take(take)
+      .collect();
+    benchmark::DoNotOptimize(taken.data());
+  }
+  Report(state, g_allocations - allocations, g_allocated_bytes - bytes);
+}
+
+static void BM_PipelineKnownSize(benchmark::State &state) {
+  MyVector<std::uint32_t> input = Input(state.range(0));
+  std::size_t allocations = g_allocations;
+  std::size_t bytes = g_allocated_bytes;
+  for (auto _ : state) {
+    auto out = my::pipe(input)
+      .transform([](std::uint32_t x) { return std::uint64_t(x) * 7 + 1; })
+      .drop(16)
+      .collect();
+    benchmark::DoNotOptimize(out.data());
+  }
+  Report(state, g_allocations - allocations, g_allocated_bytes - bytes);
+}
+
+BENCHMARK(BM_Materializing)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Pipeline)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PipelineKnownSize)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../Pipeline.h"
+
+
+template <typename T>
+void VectorTest(const MyVector<T> &mv, const std::vector<T> &expected) {
+  ASSERT_EQ(mv.size(), expected.size());
+  for (std::size_t i {0}; i < mv.size(); i++) {
+    EXPECT_EQ(mv[i], expected[i]);
+  }
+}
+
+struct PipelineTest : testing::Test {
+  MyVector<int> mv {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+};
+
+TEST_F(PipelineTest, FilterTransformTake) {
+  auto out = my::pipe(mv)
+    .filter([](int x) { return x % 2 == 0; })
+    .transform([](int x) { return x * 10; })
+    .take(3)
+    .collect();
+  VectorTest(out, {20, 40, 60});
+}
+
+TEST_F(PipelineTest, DropAndTakeSizeHint) {
+  auto p = my::pipe(mv).drop(2).take(5);
+  EXPECT_EQ(p.size_hint(), 5);
+  VectorTest(p.collect(), {3, 4, 5, 6, 7});
+  EXPECT_EQ(my::pipe(mv).drop(20).count(), 0);
+  EXPECT_EQ(my::pipe(mv).filter([](int x) { return x > 3; }).size_hint(), my::kUnknownSize);
+}
+
+TEST_F(PipelineTest, CollectReservesKnownSize) {
+  auto out = my::pipe(mv).transform([](int x) { return x + 1; }).collect();
+  EXPECT_EQ(out.size(), 10);
+  EXPECT_EQ(out.capacity(), 10);
+}
+
+TEST_F(PipelineTest, CollectIntoStdVector) {
+  auto out = my::pipe(mv).take(2).collect<std::vector>();
+  EXPECT_EQ(out, (std::vector<int>{1, 2}));
+}
+
+TEST_F(PipelineTest, ChunkMethod) {
+  std::vector<int> sums;
+  my::pipe(mv).chunk(4).for_each([&](my::VectorView<const int> chunk) {
+    int sum {0};
+    for (int x : chunk) {
+      sum += x;
+    }
+    sums.push_back(sum);
+  });
+  EXPECT_EQ(sums, (std::vector<int>{10, 26, 19}));
+  EXPECT_EQ(my::pipe(mv).chunk(4).size_hint(), 3);
+}
+
+TEST_F(PipelineTest, ChunkThenTake) {
+  EXPECT_EQ(my::pipe(mv).chunk(3).take(2).count(), 2);
+  EXPECT_EQ(my::pipe(mv).take(5).chunk(3).count(), 2);
+}
+
+TEST_F(PipelineTest, ChunkOfZeroThrows) {
+  EXPECT_THROW(my::pipe(mv).chunk(0), std::invalid_argument);
+}
+
+TEST_F(PipelineTest, EnumerateMethod) {
+  auto out = my::pipe(mv).drop(7).enumerate().collect();
+  ASSERT_EQ(out.size(), 3);
+  EXPECT_EQ(out[0], (std::pair<std::size_t, int>(0, 8)));
+  EXPECT_EQ(out[2], (std::pair<std::size_t, int>(2, 10)));
+}
+
+TEST_F(PipelineTest, ZipMethod) {
+  MyVector<std::string> names {"a", "b", "c"};
+  auto out = my::pipe(mv).zip(names).collect();
+  ASSERT_EQ(out.size(), 3);
+  EXPECT_EQ(out[1].first, 2);
+  EXPECT_EQ(out[1].second, "b");
+}
+
+TEST_F(PipelineTest, WritesThroughReferences) {
+  my::pipe(mv).filter([](int x) { return x > 8; }).for_each([](int &x) { x = 0; });
+  EXPECT_EQ(mv[8], 0);
+  EXPECT_EQ(mv[9], 0);
+  EXPECT_EQ(mv[7], 8);
+}
+
+TEST(PipelineSources, RawArrayAndView) {
+  int array[] {3, 1, 2};
+  EXPECT_EQ(my::pipe(array).count(), 3);
+  MyVector<int> mv {1, 2, 3, 4};
+  EXPECT_EQ(my::pipe(my::VectorView<int>(mv).last(2)).collect()[0], 3);
+}
@@ -0,0 +1,168 @@
+/*
+   Epoch based reclamation: memory retired by a writer is freed only once
+   no reader that could still see it is pinned
+*/
+
+#ifndef MY_EPOCH_H
+#define MY_EPOCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "../MyVector/MyVector.h"
+#include "ThreadRecords.h"
+
+namespace my {
+
+namespace detail {
+
+/* Process wide epoch domain. Every reading thread owns a record holding
+   the epoch it pinned (0 when not reading). Pinning is a load, a store and
+   a fence on the thread's own cache line, so readers never wait and never
+   write shared memory.
+
+   Retiring a block bumps the global epoch and tags the block with the
+   epoch before the bump. A reader pinned at that epoch or earlier may have
+   loaded the old pointer; one pinned later loaded the pointer after it was
+   replaced. So a block is freed once every pinned record is past its tag. */
+class EpochDomain {
+ public:
+  /* Never destroyed, so thread exit and static destructors can still use it */
+  static EpochDomain &Instance() {
+    static EpochDomain* domain = new EpochDomain();
+    return *domain;
+  }
+
+  /* Pins the calling thread. Nested pins only count. */
+  void Pin() {
+    Local &local = ThreadLocal();
+    if (local.depth++ > 0) {
+      return;
+    }
+    if (local.record == nullptr) {
+      local.record = records_.Acquire();
+    }
+    local.record->epoch.store(epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    // Orders the pin before the reader's loads of published pointers, and
+    // pairs with the fence in Collect
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  void Unpin() {
+    Local &local = ThreadLocal();
+    if (--local.depth == 0) {
+      local.record->epoch.store(0, std::memory_order_release);
+    }
+  }
+
+  /* Hands p to the domain; deleter(p) runs once no reader can reach it.
+     The pointer to p must already have been replaced. */
+  void Retire(void* p, void (*deleter)(void*)) {
+    std::uint64_t tag = epoch_.fetch_add(1, std::memory_order_seq_cst);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      retired_.push_back(Retired {p, deleter, tag});
+    }
+    Collect();
+  }
+
+  /* Frees whatever retired memory no pinned reader can still see; returns
+     how much is left waiting */
+  std::size_t Collect() {
+    // Only blocks retired before the scan are judged by it. One another
+    // writer retires meanwhile may have been loaded by a reader that
+    // pinned after its record was read, but its tag is at least this.
+    std::uint64_t oldest = epoch_.load(std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (Record* r = records_.head(); r != nullptr; r = r->next) {
+      std::uint64_t pinned = r->epoch.load(std::memory_order_acquire);
+      if (pinned != 0 && pinned < oldest) {
+        oldest = pinned;
+      }
+    }
+
+    MyVector<Retired> ready;
+    std::size_t left {0};
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::size_t kept {0};
+      for (std::size_t i {0}; i < retired_.size(); i++) {
+        if (retired_[i].tag < oldest) {
+          ready.push_back(retired_[i]);
+        } else {
+          retired_[kept++] = retired_[i];
+        }
+      }
+      while (retired_.size() > kept) {
+        retired_.pop_back();
+      }
+      left = kept;
+    }
+    for (std::size_t i {0}; i < ready.size(); i++) { // Outside the lock, deleters may be slow
+      ready[i].deleter(ready[i].p);
+    }
+    return left;
+  }
+
+  /* Retired blocks not freed yet */
+  std::size_t Pending() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return retired_.size();
+  }
+
+ private:
+  EpochDomain() = default;
+
+  /* One per thread that ever read, reused after the thread exits */
+  struct alignas(64) Record {
+    std::atomic<std::uint64_t> epoch {0};
+    std::atomic<bool> used {true};
+    Record* next = nullptr;
+  };
+
+  struct Local {
+    Record* record = nullptr;
+    std::size_t depth = 0;
+
+    ~Local() {
+      if (record != nullptr) {
+        ThreadRecordList<Record>::Release(record);
+      }
+    }
+  };
+
+  struct Retired {
+    void* p = nullptr;
+    void (*deleter)(void*) = nullptr;
+    std::uint64_t tag = 0;
+  };
+
+  static Local &ThreadLocal() {
+    thread_local Local local;
+    return local;
+  }
+
+  std::atomic<std::uint64_t> epoch_ {1}; // 0 marks an unpinned record
+  ThreadRecordList<Record> records_;
+  std::mutex mutex_; // Guards retired_, writers only
+  MyVector<Retired> retired_;
+};
+
+} // namespace detail
+
+/* Keeps everything the calling thread loads from an RcuVector alive until
+   it goes out of scope */
+class EpochGuard {
+ public:
+  EpochGuard() { detail::EpochDomain::Instance().Pin(); }
+  ~EpochGuard() { detail::EpochDomain::Instance().Unpin(); }
+
+  EpochGuard(const EpochGuard &) = delete;
+  EpochGuard &operator=(const EpochGuard &) = delete;
+};
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,184 @@
+/*
+   Append only vector for one writer and any number of wait-free readers
+*/
+
+#ifndef MY_RCU_VECTOR_H
+#define MY_RCU_VECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "../MyVector/MyVector.h"
+#include "../MyVectorView/VectorView.h"
+#include "Epoch.h"
+
+namespace my {
+
+/* MyVector's growth frees the old block under anyone still indexing it, so
+   sharing one with readers needs a lock around every read. Here the block
+   pointer and the size are atomics instead: the writer fills a slot past
+   the size and then publishes the new size, and on growth copies into a
+   bigger block, publishes it and retires the old one to the epoch domain.
+   Readers pin an epoch, load the size and then the block, and read.
+   Published elements never change, and a retired block stays alive while
+   a reader pinned before its retirement is still reading.
+
+   Writer members (push_back, emplace_back, reserve, capacity) must only be
+   called by one thread at a time. Readers use read(), load() or size().
+   A writer appending one of the published elements must hold the
+   ReadGuard it got the element from until the call returns, since growth
+   retires the block the element sits in.
+
+   Slots are default constructed when a block is allocated and appended
+   elements assigned into them, so T must be default constructible and
+   copy assignable. */
+template <typename T>
+class RcuVector {
+ public:
+  using ValueType = T;
+  using PointerType = const ValueType*;
+  using ReferenceType = const ValueType&;
+  using Iterator = PointerType;
+
+  /* A pinned view of the elements published when it was taken. Valid, and
+     unaffected by later appends, until it goes out of scope. */
+  class ReadGuard {
+   public:
+    ReferenceType operator[](std::size_t i) const { return data_[i]; }
+
+    ReferenceType at(std::size_t pos) const {
+      if (pos >= size_) {
+        throw std::out_of_range("Larger than this->size()");
+      }
+      return data_[pos];
+    }
+
+    std::size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    Iterator begin() const { return data_; }
+    Iterator end() const { return data_ + size_; }
+
+    VectorView<const T> view() const { return VectorView<const T>(data_, size_); }
+
+   private:
+    friend class RcuVector;
+
+    explicit ReadGuard(const RcuVector &vector) {
+      size_ = vector.size_.load(std::memory_order_acquire); // Size first: any later block holds it
+      data_ = vector.block_.load(std::memory_order_acquire)->data;
+    }
+
+    EpochGuard pin_; // Constructed before the loads above
+    const T* data_ = nullptr;
+    std::size_t size_ = 0;
+  };
+
+ public:
+  RcuVector() : block_(new Block(kMinCapacity)) {}
+
+  explicit RcuVector(std::size_t cap) : block_(new Block(cap < kMinCapacity ? kMinCapacity : cap)) {}
+
+  RcuVector(const RcuVector &) = delete;
+  RcuVector &operator=(const RcuVector &) = delete;
+
+  /* No reader may be using the vector any more */
+  ~RcuVector() {
+    delete block_.load(std::memory_order_relaxed);
+    detail::EpochDomain::Instance().Collect();
+  }
+
+  /* Readers */
+
+  ReadGuard read() const { return ReadGuard(*this); }
+
+  /* Copy of element pos, taken under a pin of its own */
+  T load(std::size_t pos) const {
+    ReadGuard guard(*this);
+    return guard.at(pos);
+  }
+
+  std::size_t size() const { return size_.load(std::memory_order_acquire); }
+
+  bool empty() const { return size() == 0; }
+
+  /* Writer */
+
+  std::size_t capacity() const { return block_.load(std::memory_order_relaxed)->elements.size(); }
+
+  void reserve(std::size_t cap) {
+    if (cap > capacity()) {
+      Grow(cap);
+    }
+  }
+
+  void push_back(const T &value) {
+    Slot() = value;
+    Publish();
+  }
+
+  void push_back(T &&value) {
+    Slot() = std::move(value);
+    Publish();
+  }
+
+  /* Builds a T from args and move assigns it into the next slot */
+  template <typename... Args>
+  void emplace_back(Args &&... args) {
+    Slot() = T(std::forward<Args>(args)...);
+    Publish();
+  }
+
+ private:
+  static constexpr std::size_t kMinCapacity = 16;
+
+  struct Block {
+    explicit Block(std::size_t cap) {
+      elements.resize(cap);
+      data = elements.data();
+    }
+
+    MyVector<T> elements; // Default constructed slots, assigned as they are appended
+    T* data = nullptr;
+  };
+
+  static void DeleteBlock(void* block) { delete static_cast<Block*>(block); }
+
+  /* The next free slot, growing first if there is none */
+  T& Slot() {
+    std::size_t n = size_.load(std::memory_order_relaxed);
+    Block* block = block_.load(std::memory_order_relaxed);
+    if (n == block->elements.size()) {
+      Grow(2 * n);
+      block = block_.load(std::memory_order_relaxed);
+    }
+    return block->data[n];
+  }
+
+  void Publish() {
+    size_.store(size_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /* Copies into a block of cap slots, publishes it and retires the old one.
+     Copies rather than moves: readers may still be reading the old block. */
+  void Grow(std::size_t cap) {
+    Block* old = block_.load(std::memory_order_relaxed);
+    Block* bigger = new Block(cap);
+    std::size_t n = size_.load(std::memory_order_relaxed);
+    for (std::size_t i {0}; i < n; i++) {
+      bigger->data[i] = old->data[i];
+    }
+    block_.store(bigger, std::memory_order_release);
+    detail::EpochDomain::Instance().Retire(old, &DeleteBlock);
+  }
+
+  std::atomic<Block*> block_;
+  std::atomic<std::size_t> size_ {0};
+};
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,59 @@
+/*
+   Lock free list of per thread records that outlive their threads
+*/
+
+#ifndef MY_THREAD_RECORDS_H
+#define MY_THREAD_RECORDS_H
+
+#include <atomic>
+
+namespace my {
+
+namespace detail {
+
+/* Records of the threads using some process wide service, such as the
+   epoch a reader pinned or the queue a thread retires into. A thread
+   acquires one the first time it needs it and releases it when it exits;
+   the next thread to acquire takes over a released record instead of
+   linking in a new one, so the list only grows with the most threads alive
+   at once. Records are never unlinked or freed, so the service can walk
+   them with head() and next, without a lock, while threads come and go.
+
+   Record needs a std::atomic<bool> used, true once constructed, and a
+   Record* next. */
+template <typename Record>
+class ThreadRecordList {
+ public:
+  /* Takes over a released record, or links in a new one */
+  Record* Acquire() {
+    for (Record* r = head(); r != nullptr; r = r->next) {
+      bool expected = false;
+      if (!r->used.load(std::memory_order_relaxed) &&
+          r->used.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return r;
+      }
+    }
+    Record* r = new Record();
+    r->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return r;
+  }
+
+  /* Called by the owning thread, typically from a thread_local destructor.
+     The owner's last writes to the record are visible to the next one. */
+  static void Release(Record* r) {
+    r->used.store(false, std::memory_order_release);
+  }
+
+  Record* head() const { return head_.load(std::memory_order_acquire); }
+
+ private:
+  std::atomic<Record*> head_ {nullptr};
+};
+
+} // namespace detail
+
+} // Namespace bracket
+
+#endif
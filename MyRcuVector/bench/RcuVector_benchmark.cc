@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <benchmark/benchmark.h>
+#include "../RcuVector.h"
+
+// Random reads from a vector of 1M uint64_t by 1 to 16 threads, through an
+// RcuVector against a MyVector behind a std::shared_mutex. Every iteration
+// is one read with its own pin or shared lock. The WithWriter variants
+// keep thread 0 appending instead of reading. Readers of the RcuVector
+// only touch their own epoch record, so their throughput should grow with
+// the thread count; the shared lock's reader count is one contended line.
+
+static constexpr std::size_t kSize = 1 << 20;
+static constexpr std::size_t kMask = kSize - 1;
+
+static my::RcuVector<std::uint64_t>* rcu = nullptr;
+static MyVector<std::uint64_t>* locked = nullptr;
+static std::shared_mutex lock;
+
+static void SetUpRcu(const benchmark::State &) {
+  rcu = new my::RcuVector<std::uint64_t>();
+  for (std::size_t i {0}; i < kSize; i++) {
+    rcu->push_back(i);
+  }
+}
+
+static void TearDownRcu(const benchmark::State &) {
+  delete rcu;
+}
+
+static void SetUpLocked(const benchmark::State &) {
+  locked = new MyVector<std::uint64_t>();
+  for (std::size_t i {0}; i < kSize; i++) {
+    locked->push_back(i);
+  }
+}
+
+static void TearDownLocked(const benchmark::State &) {
+  delete locked;
+}
+
+static void BM_RcuRead(benchmark::State &state) {
+  std::uint64_t i = state.thread_index() * 7919, sum {0};
+  for (auto _ : state) {
+    i = (i * 6364136223846793005ull + 1442695040888963407ull);
+    auto guard = rcu->read();
+    sum += guard[(i >> 20) & kMask];
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_SharedMutexRead(benchmark::State &state) {
+  std::uint64_t i = state.thread_index() * 7919, sum {0};
+  for (auto _ : state) {
+    i = (i * 6364136223846793005ull + 1442695040888963407ull);
+    std::shared_lock<std::shared_mutex> guard(lock);
+    sum += (*locked)[static_cast<std::size_t>((i >> 20) & kMask)];
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_RcuReadWithWriter(benchmark::State &state) {
+  if (state.thread_index() == 0) {
+    std::uint64_t next {kSize};
+    for (auto _ : state) {
+      rcu->push_back(next++);
+    }
+    return;
+  }
+  BM_RcuRead(state);
+}
+
+static void BM_SharedMutexReadWithWriter(benchmark::State &state) {
+  if (state.thread_index() == 0) {
+    std::uint64_t next {kSize};
+    for (auto _ : state) {
+      std::unique_lock<std::shared_mutex> guard(lock);
+      locked->push_back(next++);
+    }
+    return;
+  }
+  BM_SharedMutexRead(state);
+}
+
+BENCHMARK(BM_RcuRead)->Setup(SetUpRcu)->Teardown(TearDownRcu)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_SharedMutexRead)->Setup(SetUpLocked)->Teardown(TearDownLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_RcuReadWithWriter)->Setup(SetUpRcu)->Teardown(TearDownRcu)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK(BM_SharedMutexReadWithWriter)->Setup(SetUpLocked)->Teardown(TearDownLocked)->ThreadRange(2, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
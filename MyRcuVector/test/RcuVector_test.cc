@@ -0,0 +1,157 @@
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../RcuVector.h"
+
+using my::RcuVector;
+
+TEST(RcuVector, PushBackAndRead) {
+  RcuVector<int> v;
+  EXPECT_TRUE(v.empty());
+  for (int i {0}; i < 100; i++) {
+    v.push_back(i);
+  }
+  EXPECT_EQ(v.size(), 100);
+  EXPECT_GE(v.capacity(), 100);
+  auto guard = v.read();
+  ASSERT_EQ(guard.size(), 100);
+  for (int i {0}; i < 100; i++) {
+    EXPECT_EQ(guard[i], i);
+  }
+  int sum {0};
+  for (int x : guard) {
+    sum += x;
+  }
+  EXPECT_EQ(sum, 4950);
+  EXPECT_EQ(guard.view().back(), 99);
+  EXPECT_EQ(v.load(42), 42);
+}
+
+TEST(RcuVector, OutOfRange) {
+  RcuVector<int> v;
+  v.push_back(1);
+  EXPECT_THROW(v.load(1), std::out_of_range);
+  EXPECT_THROW(v.read().at(5), std::out_of_range);
+}
+
+TEST(RcuVector, GuardOutlivesGrowth) {
+  RcuVector<std::string> v;
+  for (int i {0}; i < 16; i++) {
+    v.emplace_back(std::to_string(i) + " is long enough to be on the heap");
+  }
+  {
+    auto guard = v.read();
+    const std::string* first = &guard[0];
+    for (int i {16}; i < 1000; i++) {
+      v.push_back(std::to_string(i));
+    }
+    EXPECT_GT(v.capacity(), 16);
+    EXPECT_GT(my::detail::EpochDomain::Instance().Pending(), 0); // Kept for the guard
+    EXPECT_EQ(guard.size(), 16); // Snapshot taken before the appends
+    EXPECT_EQ(*first, "0 is long enough to be on the heap");
+    EXPECT_EQ(guard[15], "15 is long enough to be on the heap");
+  }
+  EXPECT_EQ(my::detail::EpochDomain::Instance().Collect(), 0);
+  EXPECT_EQ(v.load(999), "999");
+}
+
+TEST(RcuVector, PushBackOwnElement) {
+  RcuVector<std::string> v;
+  v.push_back(std::string(64, 'x'));
+  for (int i {0}; i < 100; i++) {
+    v.push_back(v.read()[0]); // The temporary guard keeps the retired block alive
+  }
+  auto guard = v.read();
+  for (const auto &s : guard) {
+    ASSERT_EQ(s, std::string(64, 'x'));
+  }
+}
+
+TEST(RcuVector, ReserveKeepsElements) {
+  RcuVector<int> v;
+  for (int i {0}; i < 10; i++) {
+    v.push_back(i);
+  }
+  v.reserve(10000);
+  EXPECT_GE(v.capacity(), 10000);
+  EXPECT_EQ(v.size(), 10);
+  EXPECT_EQ(v.load(9), 9);
+}
+
+TEST(RcuVector, ConcurrentReadersSeeAppends) {
+  RcuVector<std::uint64_t> v;
+  const std::uint64_t n = 200000;
+  std::atomic<bool> done {false};
+  std::atomic<std::uint64_t> bad {0};
+  std::vector<std::thread> readers;
+  for (int r {0}; r < 4; r++) {
+    readers.emplace_back([&]() {
+      std::size_t last {0};
+      while (!done.load()) {
+        auto guard = v.read();
+        if (guard.size() < last) {
+          bad++;
+        }
+        last = guard.size();
+        for (std::size_t i = last > 64 ? last - 64 : 0; i < last; i++) {
+          if (guard[i] != i * 3) {
+            bad++;
+          }
+        }
+      }
+    });
+  }
+  for (std::uint64_t i {0}; i < n; i++) {
+    v.push_back(i * 3);
+  }
+  done = true;
+  for (auto &t : readers) {
+    t.join();
+  }
+  EXPECT_EQ(bad.load(), 0);
+  EXPECT_EQ(v.size(), n);
+  EXPECT_EQ(my::detail::EpochDomain::Instance().Collect(), 0);
+}
+
+TEST(RcuVector, WritersOfSeveralVectorsShareTheDomain) {
+  // One writer per vector, but every retire and collect goes through the
+  // one process wide epoch domain
+  const int kVectors = 3;
+  const std::uint64_t n = 50000;
+  RcuVector<std::uint64_t> vs[kVectors];
+  std::atomic<int> writing {kVectors};
+  std::atomic<std::uint64_t> bad {0};
+  std::vector<std::thread> threads;
+  for (int r {0}; r < 3; r++) {
+    threads.emplace_back([&, r]() {
+      while (writing.load() > 0) {
+        auto guard = vs[r % kVectors].read();
+        for (std::size_t i = guard.size() > 64 ? guard.size() - 64 : 0; i < guard.size(); i++) {
+          if (guard[i] != i * 3) {
+            bad++;
+          }
+        }
+      }
+    });
+  }
+  for (int w {0}; w < kVectors; w++) {
+    threads.emplace_back([&, w]() {
+      for (std::uint64_t i {0}; i < n; i++) {
+        vs[w].push_back(i * 3);
+      }
+      writing--;
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(bad.load(), 0);
+  for (int w {0}; w < kVectors; w++) {
+    EXPECT_EQ(vs[w].size(), n);
+  }
+  EXPECT_EQ(my::detail::EpochDomain::Instance().Collect(), 0);
+}
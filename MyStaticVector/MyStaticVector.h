@@ -0,0 +1,301 @@
+#ifndef MY_STATIC_VECTOR_H
+#define MY_STATIC_VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../MyVector/MyVector.h"
+
+// Storage for MyStaticVector. Elements live in an inline, uninitialized
+// buffer, so the container never touches the heap. When T is trivially
+// copyable the whole object is too and copies become a plain memcpy.
+template <typename T, std::size_t N, bool = std::is_trivially_copyable<T>::value>
+class MyStaticVectorStorage {
+ protected:
+  MyStaticVectorStorage() = default;
+
+  T* Data() { return reinterpret_cast<T*>(storage_); }
+  const T* Data() const { return reinterpret_cast<const T*>(storage_); }
+  void DestroyAll() { size_ = 0; }
+
+  std::size_t size_ = 0; // Number of constructed elements
+  alignas(T) unsigned char storage_[(N > 0 ? N : 1) * sizeof(T)];
+};
+
+template <typename T, std::size_t N>
+class MyStaticVectorStorage<T, N, false> {
+ protected:
+  MyStaticVectorStorage() = default;
+
+  MyStaticVectorStorage(const MyStaticVectorStorage &rhs) { // Copy constructor
+    for (std::size_t i {0}; i < rhs.size_; i++) {
+      ::new (static_cast<void*>(Data() + i)) T(rhs.Data()[i]);
+    }
+    size_ = rhs.size_;
+  }
+
+  MyStaticVectorStorage(MyStaticVectorStorage &&rhs) { // Move constructor
+    for (std::size_t i {0}; i < rhs.size_; i++) {
+      ::new (static_cast<void*>(Data() + i)) T(std::move(rhs.Data()[i]));
+    }
+    size_ = rhs.size_;
+    rhs.DestroyAll();
+  }
+
+  MyStaticVectorStorage &operator=(const MyStaticVectorStorage &rhs) {
+    if (this == &rhs) {
+      return *this;
+    }
+    DestroyAll();
+    for (std::size_t i {0}; i < rhs.size_; i++) {
+      ::new (static_cast<void*>(Data() + i)) T(rhs.Data()[i]);
+    }
+    size_ = rhs.size_;
+    return *this;
+  }
+
+  MyStaticVectorStorage &operator=(MyStaticVectorStorage &&rhs) {
+    if (this == &rhs) {
+      return *this;
+    }
+    DestroyAll();
+    for (std::size_t i {0}; i < rhs.size_; i++) {
+      ::new (static_cast<void*>(Data() + i)) T(std::move(rhs.Data()[i]));
+    }
+    size_ = rhs.size_;
+    rhs.DestroyAll();
+    return *this;
+  }
+
+  ~MyStaticVectorStorage() {
+    DestroyAll();
+  }
+
+  T* Data() { return reinterpret_cast<T*>(storage_); }
+  const T* Data() const { return reinterpret_cast<const T*>(storage_); }
+  void DestroyAll() {
+    for (std::size_t i {0}; i < size_; i++) {
+      Data()[i].~T();
+    }
+    size_ = 0;
+  }
+
+  std::size_t size_ = 0; // Number of constructed elements
+  alignas(T) unsigned char storage_[(N > 0 ? N : 1) * sizeof(T)];
+};
+
+// Fixed capacity vector with the MyVector interface. Checked selects what
+// happens when an operation would grow past N: throw std::length_error
+// (true) or trust the caller and skip the test entirely (false).
+template <typename T, std::size_t N, bool Checked = true>
+class MyStaticVector : private MyStaticVectorStorage<T, N> {
+  using Base = MyStaticVectorStorage<T, N>;
+  using Base::size_;
+  using Base::Data;
+
+ public:
+  using ValueType = T;
+  using PointerType = ValueType*;
+  using ReferenceType = ValueType&;
+  using Iterator = MyVectorIterator<MyStaticVector<T, N, Checked>>;
+  using ConstIterator = const MyVectorIterator<MyStaticVector<T, N, Checked>>;
+  using ReverseIterator = MyVectorReverseIterator<MyStaticVector<T, N, Checked>>;
+  using ConstReverseIterator = const MyVectorReverseIterator<MyStaticVector<T, N, Checked>>;
+
+ public:
+  // Constructors:
+  MyStaticVector() = default;
+
+  MyStaticVector(std::initializer_list<T> elements) { // Using initializer list
+    CheckCapacity(elements.size());
+    for (const auto &x : elements) {
+      ::new (static_cast<void*>(Data() + size_)) T(x);
+      size_++;
+    }
+  }
+
+  explicit MyStaticVector(std::size_t n) { // Size of vector
+    resize(n);
+  }
+
+  MyStaticVector(std::size_t n, const ValueType &value) { // Copies of specified element
+    resize(n, value);
+  }
+
+  // Element Access Methods
+  ValueType at(std::size_t pos) const { // Find element at index with bounds checking
+    if (pos >= size_) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    return Data()[pos];
+  }
+  PointerType front() { // Return pointer to the first element
+    return Data();
+  }
+  PointerType back() { // Return pointer to the last element
+    return Data() + size_ - 1;
+  }
+  PointerType data() { return Data(); }
+  const ValueType* data() const { return Data(); }
+
+  // Iterators
+  Iterator begin() {
+    return Iterator(Data());
+  }
+  ConstIterator cbegin() const {
+    return ConstIterator(const_cast<PointerType>(Data()));
+  }
+  Iterator end() {
+    return Iterator(Data() + size_);
+  }
+  ConstIterator cend() const {
+    return ConstIterator(const_cast<PointerType>(Data()) + size_);
+  }
+  ReverseIterator rbegin() {
+    return ReverseIterator(Data() + size_ - 1);
+  }
+  ConstReverseIterator crbegin() const {
+    return ConstReverseIterator(const_cast<PointerType>(Data()) + size_ - 1);
+  }
+  ReverseIterator rend() {
+    return ReverseIterator(Data() - 1);
+  }
+  ConstReverseIterator crend() const {
+    return ConstReverseIterator(const_cast<PointerType>(Data()) - 1);
+  }
+
+  // Capacity Methods
+  std::size_t size() const { return size_; }
+
+  static constexpr std::size_t capacity() { return N; }
+
+  static constexpr std::size_t max_size() { return N; }
+
+  bool empty() const { return size_ == 0; }
+
+  bool full() const { return size_ == N; }
+
+  void reserve(std::size_t cap) { // Storage is fixed; only validates the request
+    CheckCapacity(cap);
+  }
+
+  void shrink_to_fit() {}
+
+  // Modifier Methods
+  void clear() {
+    Base::DestroyAll();
+  }
+
+  Iterator insert(Iterator pos, const ValueType &val) {
+    return emplace(pos, val);
+  }
+
+  Iterator insert(Iterator pos, ValueType &&val) {
+    return emplace(pos, std::move(val));
+  }
+
+  template <typename ...Args>
+  Iterator emplace(Iterator pos, Args&& ...args) {
+    std::size_t index = pos.ptr_ - Data();
+    CheckCapacity(size_ + 1);
+    if (index == size_) {
+      ::new (static_cast<void*>(Data() + size_)) T(std::forward<Args>(args)...);
+      size_++;
+      return Iterator(Data() + index);
+    }
+    // Build the value first in case args alias an element we are about to move.
+    T tmp(std::forward<Args>(args)...);
+    ::new (static_cast<void*>(Data() + size_)) T(std::move(Data()[size_ - 1]));
+    for (std::size_t i {size_ - 1}; i > index; i--) {
+      Data()[i] = std::move(Data()[i - 1]);
+    }
+    Data()[index] = std::move(tmp);
+    size_++;
+    return Iterator(Data() + index);
+  }
+
+  Iterator erase(Iterator pos) {
+    return erase(pos, pos + 1);
+  }
+
+  Iterator erase(Iterator first, Iterator last) {
+    std::size_t begin = first.ptr_ - Data();
+    std::size_t end = last.ptr_ - Data();
+    if (begin == end) {
+      return first;
+    }
+    std::size_t removed = end - begin;
+    for (std::size_t i {begin}; i + removed < size_; i++) {
+      Data()[i] = std::move(Data()[i + removed]);
+    }
+    for (std::size_t i {size_ - removed}; i < size_; i++) {
+      Data()[i].~T();
+    }
+    size_ -= removed;
+    return first;
+  }
+
+  void push_back(const ValueType &element) {
+    emplace_back(element);
+  }
+
+  void push_back(ValueType &&element) {
+    emplace_back(std::move(element));
+  }
+
+  template <typename ...Args>
+  void emplace_back(Args&& ...args) {
+    CheckCapacity(size_ + 1);
+    ::new (static_cast<void*>(Data() + size_)) T(std::forward<Args>(args)...);
+    size_++;
+  }
+
+  void pop_back() {
+    size_--;
+    Data()[size_].~T();
+  }
+
+  void resize(std::size_t count) {
+    CheckCapacity(count);
+    while (size_ > count) {
+      pop_back();
+    }
+    while (size_ < count) {
+      ::new (static_cast<void*>(Data() + size_)) T();
+      size_++;
+    }
+  }
+
+  void resize(std::size_t count, const ValueType &value) {
+    CheckCapacity(count);
+    while (size_ > count) {
+      pop_back();
+    }
+    while (size_ < count) {
+      ::new (static_cast<void*>(Data() + size_)) T(value);
+      size_++;
+    }
+  }
+
+  // Operators
+  ValueType &operator[](std::size_t i) {
+    return Data()[i];
+  }
+
+  const ValueType &operator[](std::size_t i) const {
+    return Data()[i];
+  }
+
+ private:
+  static void CheckCapacity(std::size_t count) {
+    if (Checked && count > N) {
+      throw std::length_error("MyStaticVector capacity exceeded");
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../MyStaticVector.h"
+
+using std::vector;
+
+static_assert(std::is_trivially_copyable<MyStaticVector<int, 8>>::value,
+              "MyStaticVector of a trivially copyable type should be trivially copyable");
+static_assert(!std::is_trivially_copyable<MyStaticVector<std::string, 8>>::value,
+              "MyStaticVector of std::string needs real copy operations");
+
+TEST(StaticVectorConstructors, DefaultConstructor) {
+  MyStaticVector<int, 4> sv;
+  EXPECT_EQ(sv.size(), 0);
+  EXPECT_EQ(sv.capacity(), 4);
+  EXPECT_TRUE(sv.empty());
+}
+
+TEST(StaticVectorConstructors, InitializerList) {
+  MyStaticVector<int, 8> sv {1, 2, 3, 4, 5};
+  std::vector<int> v {1, 2, 3, 4, 5};
+  ASSERT_EQ(sv.size(), v.size());
+  for (std::size_t i {0}; i < sv.size(); i++) {
+    EXPECT_EQ(sv[i], v[i]);
+  }
+}
+
+TEST(StaticVectorConstructors, SizeElementConstructor) {
+  MyStaticVector<int, 16> sv (10, 5);
+  std::vector<int> v (10, 5);
+  ASSERT_EQ(sv.size(), v.size());
+  for (std::size_t i {0}; i < sv.size(); i++) {
+    EXPECT_EQ(sv[i], v[i]);
+  }
+}
+
+TEST(StaticVectorConstructors, CopyAndMoveNonTrivial) {
+  MyStaticVector<std::string, 4> sv {"a", "b", "c"};
+  MyStaticVector<std::string, 4> copy {sv};
+  MyStaticVector<std::string, 4> moved {std::move(sv)};
+  EXPECT_TRUE(sv.empty());
+  ASSERT_EQ(copy.size(), 3);
+  ASSERT_EQ(moved.size(), 3);
+  EXPECT_EQ(copy[2], "c");
+  EXPECT_EQ(moved[0], "a");
+}
+
+struct StaticVectorTest : testing::Test {
+  vector<int> std_v {1, 2, 3, 4, 5};
+  MyStaticVector<int, 10> my_v {1, 2, 3, 4, 5};
+
+  void VectorTest() {
+    ASSERT_EQ(std_v.size(), my_v.size());
+    for (std::size_t i {0}; i < my_v.size(); i++) {
+      EXPECT_EQ(std_v.at(i), my_v.at(i));
+    }
+  }
+};
+
+TEST_F(StaticVectorTest, AtMethodOutOfRange) {
+  EXPECT_THROW(my_v.at(5), std::out_of_range);
+}
+
+TEST_F(StaticVectorTest, PushBackMethod) {
+  std_v.push_back(6);
+  my_v.push_back(6);
+  VectorTest();
+}
+
+TEST_F(StaticVectorTest, EmplaceBackMethod) {
+  std_v.emplace_back(7);
+  my_v.emplace_back(7);
+  VectorTest();
+}
+
+TEST_F(StaticVectorTest, InsertMethod) {
+  auto std_it = std_v.insert(std_v.begin() + 1, 10);
+  auto my_it = my_v.insert(my_v.begin() + 1, 10);
+  EXPECT_EQ(*std_it, *my_it);
+  VectorTest();
+}
+
+TEST_F(StaticVectorTest, InsertAtEnd) {
+  std_v.insert(std_v.end(), 10);
+  my_v.insert(my_v.end(), 10);
+  VectorTest();
+}
+
+TEST_F(StaticVectorTest, EraseMethod) {
+  std_v.erase(std_v.begin() + 2);
+  my_v.erase(my_v.begin() + 2);
+  VectorTest();
+}
+
+TEST_F(StaticVectorTest, EraseRangeMethod) {
+  std_v.erase(std_v.begin() + 1, std_v.begin() + 3);
+  my_v.erase(my_v.begin() + 1, my_v.begin() + 3);
+  VectorTest();
+}
+
+TEST_F(StaticVectorTest, PopBackMethod) {
+  std_v.pop_back();
+  my_v.pop_back();
+  VectorTest();
+}
+
+TEST_F(StaticVectorTest, ResizeMethodGreaterThanSize) {
+  std_v.resize(8);
+  my_v.resize(8);
+  VectorTest();
+}
+
+TEST_F(StaticVectorTest, ResizeMethodLessThanSize) {
+  std_v.resize(3);
+  my_v.resize(3);
+  VectorTest();
+}
+
+TEST_F(StaticVectorTest, ClearMethod) {
+  std_v.clear();
+  my_v.clear();
+  VectorTest();
+}
+
+TEST_F(StaticVectorTest, Iterators) {
+  int sum {0};
+  for (auto it = my_v.begin(); it != my_v.end(); it++) {
+    sum += *it;
+  }
+  EXPECT_EQ(sum, 15);
+  EXPECT_EQ(*my_v.rbegin(), 5);
+}
+
+TEST(StaticVectorOverflow, CheckedThrows) {
+  MyStaticVector<int, 2> sv {1, 2};
+  EXPECT_TRUE(sv.full());
+  EXPECT_THROW(sv.push_back(3), std::length_error);
+  EXPECT_THROW(sv.insert(sv.begin(), 3), std::length_error);
+  EXPECT_THROW(sv.resize(3), std::length_error);
+  EXPECT_EQ(sv.size(), 2);
+}
+
+TEST(StaticVectorOverflow, UncheckedWithinCapacity) {
+  MyStaticVector<int, 2, false> sv;
+  sv.push_back(1);
+  sv.push_back(2);
+  EXPECT_EQ(sv.size(), 2);
+  EXPECT_EQ(sv[1], 2);
+}
@@ -0,0 +1,233 @@
+/*
+   Bump arena and arena backed UniquePtrs, released in bulk
+*/
+
+#ifndef MY_ARENA_H
+#define MY_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "UniquePtr.h"
+
+namespace my {
+
+template <typename T>
+struct arena_delete;
+
+namespace detail {
+
+template <typename T>
+struct ArenaLayout;
+
+} // namespace detail
+
+/* Hands out memory by bumping a pointer through large chunks and frees it
+   all at once in reset() or the destructor, so per object cost is a few
+   instructions to allocate and nothing to free. Not thread safe.
+
+   Without NDEBUG every object from make_unique_in is counted, and reset()
+   or destroying the arena while one of their UniquePtrs still owns it
+   aborts with a message instead of leaving the pointer dangling. The count
+   lives in a header before each object, so a program must not mix
+   translation units built with and without NDEBUG. */
+class Arena {
+ public:
+  explicit Arena(std::size_t first_chunk = 4096)
+    : next_chunk_(first_chunk < kMinChunk ? kMinChunk : first_chunk) {}
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  ~Arena() {
+    CheckNoLiveObjects("destroyed");
+    while (chunks_ != nullptr) {
+      Chunk* prev = chunks_->prev;
+      ::operator delete(chunks_);
+      chunks_ = prev;
+    }
+  }
+
+  /* bytes of uninitialized memory aligned to align, a power of two */
+  void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+    std::uintptr_t p = (reinterpret_cast<std::uintptr_t>(bump_) + align - 1) & ~(align - 1);
+    if (chunks_ == nullptr || p + bytes > reinterpret_cast<std::uintptr_t>(end_)) {
+      NewChunk(bytes + align);
+      p = (reinterpret_cast<std::uintptr_t>(bump_) + align - 1) & ~(align - 1);
+    }
+    bump_ = reinterpret_cast<char*>(p + bytes);
+    used_ += bytes;
+    return reinterpret_cast<void*>(p);
+  }
+
+  /* Frees every allocation at once. Destructors are not run; objects from
+     make_unique_in must have been destroyed or dropped already. The newest
+     chunk is kept for the next round. */
+  void reset() {
+    CheckNoLiveObjects("reset");
+    if (chunks_ == nullptr) {
+      return;
+    }
+    while (chunks_->prev != nullptr) {
+      Chunk* prev = chunks_->prev;
+      chunks_->prev = prev->prev;
+      reserved_ -= prev->size;
+      ::operator delete(prev);
+    }
+    bump_ = reinterpret_cast<char*>(chunks_ + 1);
+    used_ = 0;
+  }
+
+  /* Builds a T owned by nobody but the arena: it lives until reset() and
+     its destructor never runs. For nodes linked by raw pointer. */
+  template <typename T, typename... Args>
+  T* create(Args&&... args) {
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  /* Gives up ptr's object without running its destructor; its memory goes
+     with the next reset() of the arena that made it, which like
+     arena_delete is the one it is counted out of. This is the bulk
+     teardown: drop the root of a graph whose other nodes came from
+     create(), then reset(). */
+  template <typename T>
+  void drop(UniquePtr<T, arena_delete<T>> &&ptr) {
+    T* p = ptr.release();
+#ifndef NDEBUG
+    if (p != nullptr) {
+      detail::ArenaLayout<T>::Owner(p)->NoteDestroyed();
+    }
+#else
+    (void)p;
+#endif
+  }
+
+  /* Bytes handed out since the last reset */
+  std::size_t used_bytes() const { return used_; }
+
+  /* Bytes of chunks held */
+  std::size_t reserved_bytes() const { return reserved_; }
+
+  /* Live object count for the debug check, kept by make_unique_in and
+     arena_delete */
+  void NoteMade() {
+#ifndef NDEBUG
+    live_++;
+#endif
+  }
+
+  void NoteDestroyed() {
+#ifndef NDEBUG
+    live_--;
+#endif
+  }
+
+ private:
+  static constexpr std::size_t kMinChunk = 256;
+  static constexpr std::size_t kMaxChunk = std::size_t(1) << 20;
+
+  struct alignas(std::max_align_t) Chunk {
+    Chunk* prev;
+    std::size_t size; // Including this header
+  };
+
+  /* Starts a chunk with room for at least bytes. Chunks double up to
+     kMaxChunk; a bigger request gets a chunk of its own size. */
+  void NewChunk(std::size_t bytes) {
+    std::size_t size = next_chunk_;
+    if (size < sizeof(Chunk) + bytes) {
+      size = sizeof(Chunk) + bytes;
+    }
+    Chunk* chunk = static_cast<Chunk*>(::operator new(size));
+    chunk->prev = chunks_;
+    chunk->size = size;
+    chunks_ = chunk;
+    reserved_ += size;
+    bump_ = reinterpret_cast<char*>(chunk + 1);
+    end_ = reinterpret_cast<char*>(chunk) + size;
+    if (next_chunk_ < kMaxChunk) {
+      next_chunk_ *= 2;
+    }
+  }
+
+  void CheckNoLiveObjects(const char* what) {
+#ifndef NDEBUG
+    if (live_ != 0) {
+      std::fprintf(stderr, "my::Arena %s while %zu UniquePtr(s) from make_unique_in still own objects in it\n",
+                   what, live_);
+      std::abort();
+    }
+#endif
+  }
+
+  Chunk* chunks_ = nullptr; // Newest first
+  char* bump_ = nullptr;
+  char* end_ = nullptr;
+  std::size_t next_chunk_;
+  std::size_t used_ = 0;
+  std::size_t reserved_ = 0;
+#ifndef NDEBUG
+  std::size_t live_ = 0;
+#endif
+};
+
+namespace detail {
+
+/* Without NDEBUG each arena object is preceded by the Arena* that made it,
+   so a stateless deleter can still find the arena to count it out */
+template <typename T>
+struct ArenaLayout {
+#ifndef NDEBUG
+  static constexpr std::size_t kAlign = alignof(T) > alignof(Arena*) ? alignof(T) : alignof(Arena*);
+  static constexpr std::size_t kHeader = (sizeof(Arena*) + kAlign - 1) / kAlign * kAlign;
+#else
+  static constexpr std::size_t kAlign = alignof(T);
+  static constexpr std::size_t kHeader = 0;
+#endif
+
+  static Arena*& Owner(void* object) {
+    return *reinterpret_cast<Arena**>(static_cast<char*>(object) - sizeof(Arena*));
+  }
+};
+
+} // namespace detail
+
+/* Deleter for make_unique_in: runs the destructor, or nothing for a
+   trivially destructible T. The memory goes back with the arena. */
+template <typename T>
+struct arena_delete {
+  arena_delete() = default;
+
+  void operator()(T* ptr) const {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      ptr->~T();
+    }
+#ifndef NDEBUG
+    detail::ArenaLayout<T>::Owner(ptr)->NoteDestroyed();
+#endif
+  }
+};
+
+/* Builds a T in arena. The UniquePtr is one pointer wide and must be
+   destroyed, or dropped with Arena::drop, before the arena is reset or
+   destroyed. */
+template <typename T, typename... Args>
+UniquePtr<T, arena_delete<T>> make_unique_in(Arena &arena, Args&&... args) {
+  using Layout = detail::ArenaLayout<T>;
+  void* object = static_cast<char*>(arena.allocate(Layout::kHeader + sizeof(T), Layout::kAlign)) + Layout::kHeader;
+  T* p = new (object) T(std::forward<Args>(args)...);
+#ifndef NDEBUG
+  Layout::Owner(p) = &arena;
+#endif
+  arena.NoteMade();
+  return UniquePtr<T, arena_delete<T>>(p);
+}
+
+} // Namespace bracket
+
+#endif
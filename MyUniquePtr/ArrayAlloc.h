@@ -0,0 +1,272 @@
+/*
+   Array allocation for UniquePtr<T[]>: uninitialized, over-aligned and huge
+   page backed buffers, and a UniquePtr that carries its size
+*/
+
+#ifndef MY_ARRAY_ALLOC_H
+#define MY_ARRAY_ALLOC_H
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "UniquePtr.h"
+
+namespace my {
+
+namespace detail {
+
+template <typename T>
+constexpr bool kUnboundedArray = std::is_array<T>::value && std::extent<T>::value == 0;
+
+/* Sits just before the elements of an aligned or page array, so the
+   deleters need no state to find the allocation and destroy the elements */
+struct ArrayHeader {
+  void* base;
+  std::size_t count;
+  std::size_t bytes; // Of the whole allocation
+  std::size_t align;
+};
+
+constexpr std::size_t RoundUp(std::size_t n, std::size_t to) {
+  return (n + to - 1) / to * to;
+}
+
+constexpr std::size_t kHugePage = std::size_t(2) << 20;
+
+/* offset bytes of header and padding plus n elements, leaving room to
+   round up to a huge page */
+template <typename E>
+std::size_t ArrayBytes(std::size_t offset, std::size_t n) {
+  if (n > (std::numeric_limits<std::size_t>::max() - offset - 2 * kHugePage) / sizeof(E)) {
+    throw std::bad_array_new_length();
+  }
+  return offset + n * sizeof(E);
+}
+
+inline ArrayHeader* HeaderOf(void* data) {
+  return static_cast<ArrayHeader*>(data) - 1;
+}
+
+/* Constructs n elements at data and writes the header in front of them.
+   If a constructor throws, the elements made so far are destroyed and the
+   caller frees base. */
+template <typename E, bool Value>
+E* ConstructArray(char* data, void* base, std::size_t n, std::size_t bytes, std::size_t align) {
+  E* elements = reinterpret_cast<E*>(data);
+  if constexpr (Value) {
+    std::uninitialized_value_construct_n(elements, n);
+  } else {
+    std::uninitialized_default_construct_n(elements, n);
+  }
+  ::new (HeaderOf(data)) ArrayHeader {base, n, bytes, align};
+  return elements;
+}
+
+} // namespace detail
+
+/* Deleter for make_unique_aligned arrays */
+template <typename T>
+struct aligned_delete;
+
+template <typename T>
+struct aligned_delete<T[]> {
+  void operator()(T* ptr) const {
+    detail::ArrayHeader header = *detail::HeaderOf(ptr);
+    std::destroy_n(ptr, header.count);
+    ::operator delete(header.base, std::align_val_t(header.align));
+  }
+};
+
+/* Deleter for make_unique_pages arrays */
+template <typename T>
+struct page_delete;
+
+template <typename T>
+struct page_delete<T[]> {
+  void operator()(T* ptr) const {
+    detail::ArrayHeader header = *detail::HeaderOf(ptr);
+    std::destroy_n(ptr, header.count);
+    ::munmap(header.base, header.bytes);
+  }
+};
+
+/* n default-initialized elements: for trivial types the memory is left as
+   it comes, for buffers that are about to be overwritten anyway. Freed by
+   the usual default_delete<T[]>. */
+template <typename T, typename = std::enable_if_t<detail::kUnboundedArray<T>>>
+UniquePtr<T> make_unique_for_overwrite(std::size_t n) {
+  return UniquePtr<T>(new std::remove_extent_t<T>[n]);
+}
+
+/* n value-initialized elements whose first one is aligned to align, a
+   power of two (64 for a cache line or an AVX-512 register) */
+template <typename T, typename = std::enable_if_t<detail::kUnboundedArray<T>>>
+UniquePtr<T, aligned_delete<T>> make_unique_aligned(std::size_t n, std::size_t align) {
+  using E = std::remove_extent_t<T>;
+  if (align == 0 || (align & (align - 1)) != 0) {
+    throw std::invalid_argument("make_unique_aligned alignment is not a power of two");
+  }
+  if (align < alignof(E)) {
+    align = alignof(E);
+  }
+  if (align < alignof(detail::ArrayHeader)) {
+    align = alignof(detail::ArrayHeader);
+  }
+  std::size_t offset = detail::RoundUp(sizeof(detail::ArrayHeader), align);
+  std::size_t bytes = detail::ArrayBytes<E>(offset, n);
+  char* base = static_cast<char*>(::operator new(bytes, std::align_val_t(align)));
+  try {
+    return UniquePtr<T, aligned_delete<T>>(detail::ConstructArray<E, true>(base + offset, base, n, bytes, align));
+  } catch (...) {
+    ::operator delete(base, std::align_val_t(align));
+    throw;
+  }
+}
+
+/* n default-initialized elements in their own anonymous mapping. From
+   2 MiB up the mapping is 2 MiB aligned and marked for transparent huge
+   pages, so a large buffer takes one TLB entry per 2 MiB rather than per
+   4 KiB. Pages come zeroed from the kernel and are only faulted in when
+   first touched; the elements start 64 byte aligned. Throws std::bad_alloc
+   when the mapping fails. */
+template <typename T, typename = std::enable_if_t<detail::kUnboundedArray<T>>>
+UniquePtr<T, page_delete<T>> make_unique_pages(std::size_t n) {
+  using E = std::remove_extent_t<T>;
+  std::size_t align = alignof(E) > 64 ? alignof(E) : 64;
+  std::size_t offset = detail::RoundUp(sizeof(detail::ArrayHeader), align);
+  std::size_t bytes = detail::ArrayBytes<E>(offset, n);
+  bool huge = bytes >= detail::kHugePage;
+  bytes = detail::RoundUp(bytes, huge ? detail::kHugePage : static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)));
+
+  /* Map a huge page more than needed and trim both ends to align */
+  std::size_t mapped = huge ? bytes + detail::kHugePage : bytes;
+  void* map = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (map == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  char* base = static_cast<char*>(map);
+  if (huge) {
+    char* aligned = reinterpret_cast<char*>(
+      detail::RoundUp(reinterpret_cast<std::uintptr_t>(base), detail::kHugePage));
+    if (aligned != base) {
+      ::munmap(base, aligned - base);
+    }
+    if (aligned + bytes != base + mapped) {
+      ::munmap(aligned + bytes, base + mapped - (aligned + bytes));
+    }
+    base = aligned;
+#ifdef MADV_HUGEPAGE
+    ::madvise(base, bytes, MADV_HUGEPAGE); // Only advice: without THP the buffer still works
+#endif
+  }
+  try {
+    return UniquePtr<T, page_delete<T>>(detail::ConstructArray<E, false>(base + offset, base, n, bytes, align));
+  } catch (...) {
+    ::munmap(base, bytes);
+    throw;
+  }
+}
+
+/* A UniquePtr<T[]> that knows its element count, so it can be iterated
+   and checked. Without NDEBUG operator[] aborts on an index past size();
+   at() always throws std::out_of_range. 16 bytes with a stateless
+   deleter. */
+template <typename T, typename Deleter = my::default_delete<T>>
+class SizedUniquePtr;
+
+template <typename T, typename Deleter>
+class SizedUniquePtr<T[], Deleter> {
+ public:
+  using ValueType = T;
+  using PointerType = ValueType*;
+  using Iterator = ValueType*;
+
+ public:
+  /* Constructors */
+
+  SizedUniquePtr() = default;
+
+  /* Takes ownership of an array of size elements */
+  SizedUniquePtr(UniquePtr<T[], Deleter> &&ptr, std::size_t size)
+    : ptr_(std::move(ptr)), size_(ptr_ ? size : 0) {}
+
+  SizedUniquePtr(SizedUniquePtr &&rhs)
+    : ptr_(std::move(rhs.ptr_)), size_(rhs.size_) {
+    rhs.size_ = 0;
+  }
+
+  SizedUniquePtr &operator=(SizedUniquePtr &&rhs) {
+    if (this != &rhs) {
+      ptr_ = std::move(rhs.ptr_);
+      size_ = rhs.size_;
+      rhs.size_ = 0;
+    }
+    return *this;
+  }
+
+  /* Modifiers */
+
+  /* Gives up the array as a plain UniquePtr; the size is the caller's to
+     keep */
+  UniquePtr<T[], Deleter> release() {
+    size_ = 0;
+    return std::move(ptr_);
+  }
+
+  void reset() {
+    ptr_.reset();
+    size_ = 0;
+  }
+
+  /* Observers */
+
+  PointerType get() const { return ptr_.get(); }
+  PointerType data() const { return ptr_.get(); }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  explicit operator bool() const { return static_cast<bool>(ptr_); }
+
+  const Deleter& get_deleter() const { return ptr_.get_deleter(); }
+  Deleter& get_deleter() { return ptr_.get_deleter(); }
+
+  ValueType& operator[](std::size_t i) const {
+#ifndef NDEBUG
+    if (i >= size_) {
+      std::fprintf(stderr, "my::SizedUniquePtr index %zu out of range for size %zu\n", i, size_);
+      std::abort();
+    }
+#endif
+    return ptr_.get()[i];
+  }
+
+  ValueType& at(std::size_t i) const {
+    if (i >= size_) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    return ptr_.get()[i];
+  }
+
+  /* Iterators */
+
+  Iterator begin() const { return ptr_.get(); }
+  Iterator end() const { return ptr_.get() + size_; }
+
+ private:
+  UniquePtr<T[], Deleter> ptr_;
+  std::size_t size_ = 0;
+};
+
+} // Namespace bracket
+
+#endif
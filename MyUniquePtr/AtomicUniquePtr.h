@@ -0,0 +1,179 @@
+/*
+   Atomically published UniquePtr with epoch protected readers
+*/
+
+#ifndef MY_ATOMIC_UNIQUE_PTR_H
+#define MY_ATOMIC_UNIQUE_PTR_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "../MyRcuVector/Epoch.h"
+#include "CompressedPair.h"
+#include "UniquePtr.h"
+
+namespace my {
+
+namespace detail {
+
+/* Hands p to the epoch domain, which runs Deleter on it once no reader
+   pinned before now is left */
+template <typename T, typename Deleter>
+void RetireWith(T* p, Deleter d) {
+  if (p == nullptr) {
+    return;
+  }
+  if constexpr (std::is_empty<Deleter>::value && std::is_default_constructible<Deleter>::value) {
+    EpochDomain::Instance().Retire(p, [](void* object) { Deleter()(static_cast<T*>(object)); });
+  } else {
+    struct Holder {
+      T* object;
+      Deleter deleter;
+    };
+    EpochDomain::Instance().Retire(new Holder {p, std::move(d)}, [](void* holder) {
+      Holder* h = static_cast<Holder*>(holder);
+      h->deleter(h->object);
+      delete h;
+    });
+  }
+}
+
+} // namespace detail
+
+/* Deleter of the previous objects AtomicUniquePtr hands back: instead of
+   destroying, retires to the epoch domain, since readers may still be
+   using the object. Stateless when Deleter is, so the pointer stays 8
+   bytes. */
+template <typename T, typename Deleter = my::default_delete<T>,
+          bool = std::is_empty<Deleter>::value && std::is_default_constructible<Deleter>::value>
+struct retire_delete {
+  retire_delete() = default;
+
+  explicit retire_delete(Deleter d)
+    : deleter(std::move(d)) {}
+
+  void operator()(T* ptr) const {
+    detail::RetireWith(ptr, deleter);
+  }
+
+  Deleter deleter;
+};
+
+template <typename T, typename Deleter>
+struct retire_delete<T, Deleter, true> {
+  retire_delete() = default;
+
+  explicit retire_delete(Deleter) {}
+
+  void operator()(T* ptr) const {
+    detail::RetireWith(ptr, Deleter());
+  }
+};
+
+/* An owning pointer that one or more writers replace while any number of
+   readers use the current object. The pointer is a single atomic, so
+   exchange and compare_exchange are lock-free. Readers call load(), which
+   pins an epoch (see MyRcuVector/Epoch.h) for the life of the returned
+   guard: a thread local store and a fence, never a lock or a wait. A
+   replaced object is retired to the epoch domain and destroyed once every
+   reader pinned before the swap has let go. Every object is destroyed
+   with the deleter the AtomicUniquePtr was constructed with; the deleters
+   of the UniquePtrs passed to store, exchange and compare_exchange are
+   dropped, so with a stateful Deleter they must be equivalent to it. A
+   stateless Deleter takes no room, leaving just the atomic pointer. */
+template <typename T, typename Deleter = my::default_delete<T>>
+class AtomicUniquePtr {
+ public:
+  using ValueType = T;
+  using PointerType = ValueType*;
+  using OwnerType = UniquePtr<T, Deleter>;
+  using RetiredType = UniquePtr<T, retire_delete<T, Deleter>>;
+
+  /* The object current when load() ran, kept alive while the guard is.
+     Guards are for the thread that took them; do not keep one for long,
+     as retired objects pile up behind it. */
+  class ReadGuard {
+   public:
+    PointerType get() const { return ptr_; }
+    T& operator*() const { return *ptr_; }
+    PointerType operator->() const { return ptr_; }
+    explicit operator bool() const { return ptr_ != nullptr; }
+
+   private:
+    friend class AtomicUniquePtr;
+
+    explicit ReadGuard(const std::atomic<PointerType> &ptr)
+      : ptr_(ptr.load(std::memory_order_acquire)) {}
+
+    EpochGuard pin_; // Constructed before ptr_ is loaded
+    PointerType ptr_;
+  };
+
+ public:
+  AtomicUniquePtr() = default;
+
+  explicit AtomicUniquePtr(OwnerType &&p)
+    : storage_(p.release(), std::move(p.get_deleter())) {}
+
+  AtomicUniquePtr(const AtomicUniquePtr &) = delete;
+  AtomicUniquePtr &operator=(const AtomicUniquePtr &) = delete;
+
+  /* No reader may be using the object any more */
+  ~AtomicUniquePtr() {
+    PointerType p = storage_.first().load(std::memory_order_relaxed);
+    if (p != nullptr) {
+      storage_.second()(p);
+    }
+  }
+
+  /* Readers */
+
+  ReadGuard load() const {
+    return ReadGuard(storage_.first());
+  }
+
+  /* Writers */
+
+  /* Publishes desired and retires the previous object */
+  void store(OwnerType &&desired) {
+    exchange(std::move(desired));
+  }
+
+  void reset() {
+    store(OwnerType());
+  }
+
+  /* Publishes desired and hands back the previous object. Dropping the
+     returned pointer retires the object rather than destroying it. */
+  RetiredType exchange(OwnerType &&desired) {
+    PointerType old = storage_.first().exchange(desired.release(), std::memory_order_acq_rel);
+    return RetiredType(old, retire_delete<T, Deleter>(storage_.second()));
+  }
+
+  /* Publishes desired if the current object is still expected, and then
+     retires expected. Otherwise leaves desired with the caller, stores the
+     current object in expected and returns false. */
+  bool compare_exchange(PointerType &expected, OwnerType &desired) {
+    if (storage_.first().compare_exchange_strong(expected, desired.get(), std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+      desired.release();
+      detail::RetireWith(expected, storage_.second());
+      return true;
+    }
+    return false;
+  }
+
+  bool is_lock_free() const {
+    return storage_.first().is_lock_free();
+  }
+
+ private:
+  // Current object and the deleter copied for every retired one
+  detail::CompressedPair<std::atomic<PointerType>, Deleter> storage_ {nullptr};
+};
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,69 @@
+/*
+   Pair that takes no room for an empty second member
+*/
+
+#ifndef MY_COMPRESSED_PAIR_H
+#define MY_COMPRESSED_PAIR_H
+
+#include <type_traits>
+#include <utility>
+
+namespace my {
+
+namespace detail {
+
+/* Holds a First and an Empty. When Empty has no state and can be derived
+   from, it is a base class, and the empty base optimization folds it into
+   the First so sizeof(CompressedPair) == sizeof(First). Used for the
+   pointer and deleter of the smart pointers, where the deleter is almost
+   always stateless. */
+template <typename First, typename Empty,
+          bool = std::is_empty<Empty>::value && !std::is_final<Empty>::value>
+class CompressedPair : private Empty {
+ public:
+  CompressedPair() : Empty(), first_() {}
+
+  template <typename F>
+  explicit CompressedPair(F &&first) : Empty(), first_(std::forward<F>(first)) {}
+
+  template <typename F, typename E>
+  CompressedPair(F &&first, E &&second) : Empty(std::forward<E>(second)), first_(std::forward<F>(first)) {}
+
+  First& first() { return first_; }
+  const First& first() const { return first_; }
+
+  Empty& second() { return *this; }
+  const Empty& second() const { return *this; }
+
+ private:
+  First first_;
+};
+
+/* Stateful, function pointer or final second member: stored as is */
+template <typename First, typename Second>
+class CompressedPair<First, Second, false> {
+ public:
+  CompressedPair() : first_(), second_() {}
+
+  template <typename F>
+  explicit CompressedPair(F &&first) : first_(std::forward<F>(first)), second_() {}
+
+  template <typename F, typename S>
+  CompressedPair(F &&first, S &&second) : first_(std::forward<F>(first)), second_(std::forward<S>(second)) {}
+
+  First& first() { return first_; }
+  const First& first() const { return first_; }
+
+  Second& second() { return second_; }
+  const Second& second() const { return second_; }
+
+ private:
+  First first_;
+  Second second_;
+};
+
+} // namespace detail
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,265 @@
+/*
+   Deleter that hands objects to a background thread instead of destroying
+   them on the calling one
+*/
+
+#ifndef MY_DEFERRED_DELETE_H
+#define MY_DEFERRED_DELETE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "../MyRcuVector/ThreadRecords.h"
+#include "UniquePtr.h"
+
+namespace my {
+
+/* Counters of the deferred delete reclaimer */
+struct ReclaimStats {
+  std::size_t retired = 0;          // Objects handed to the reclaimer
+  std::size_t reclaimed = 0;        // Of those, destroyed so far
+  std::size_t pending = 0;          // Queued right now, retired - reclaimed
+  std::size_t max_pending = 0;      // Most found queued by one sweep
+  std::size_t inline_deletes = 0;   // Destroyed on the caller as its queue was full
+  std::uint64_t last_sweep_ns = 0;  // Time the last sweep spent destroying
+  std::uint64_t max_latency_ns = 0; // Bound on retire to destroy delay so far
+};
+
+namespace detail {
+
+/* Process wide reclaimer behind deferred_delete. Each thread that retires
+   owns a bounded ring that only it pushes to and only a sweep pops from, so
+   retiring is a store of two pointers and a release store of the tail: no
+   lock, no read-modify-write, no system call. A background thread sweeps
+   every ring each kSweepInterval, or sooner once a ring is half full, and
+   destroys what it finds in one batch. A thread whose ring is full
+   destroys the object itself.
+
+   Destructors run by a sweep may retire more objects; they land in the
+   sweeping thread's own ring and go in the next sweep, so a deep graph
+   comes apart a level per sweep instead of recursing. An exited thread's
+   ring stays in the list, and whatever it still holds is swept, until
+   another thread that retires takes it over. */
+class Reclaimer {
+ public:
+  static constexpr std::size_t kRingSize = 4096;
+  static constexpr std::chrono::milliseconds kSweepInterval {1};
+
+  /* Leaked: objects retired by thread_local and static destructors, and
+     the background thread itself, may all come after exit() */
+  static Reclaimer &Instance() {
+    static Reclaimer* reclaimer = new Reclaimer();
+    return *reclaimer;
+  }
+
+  /* Queues p for deleter(p) on the background thread */
+  void Retire(void* p, void (*deleter)(void*)) {
+    Local &local = ThreadLocal();
+    if (local.ring == nullptr) {
+      if (local.exited) { // Thread local destructors running after ours
+        deleter(p);
+        return;
+      }
+      local.ring = rings_.Acquire();
+      std::call_once(started_, [this]() { std::thread([this]() { Run(); }).detach(); });
+    }
+    Ring &ring = *local.ring;
+    std::size_t tail = ring.tail.load(std::memory_order_relaxed);
+    if (tail - ring.cached_head >= kRingSize) {
+      ring.cached_head = ring.head.load(std::memory_order_acquire);
+      if (tail - ring.cached_head >= kRingSize) {
+        ring.inline_deletes.fetch_add(1, std::memory_order_relaxed);
+        wake_.notify_one();
+        deleter(p);
+        return;
+      }
+    }
+    ring.slots[tail % kRingSize] = Entry {p, deleter};
+    ring.tail.store(tail + 1, std::memory_order_release);
+    if (tail + 1 - ring.cached_head == kRingSize / 2) {
+      wake_.notify_one();
+    }
+  }
+
+  /* Destroys everything retired before the call, including what those
+     destructors retire in turn, on the calling thread */
+  void Flush() {
+    while (Sweep() != 0) {
+    }
+  }
+
+  ReclaimStats Stats() const {
+    ReclaimStats stats;
+    for (Ring* r = rings_.head(); r != nullptr; r = r->next) {
+      std::size_t head = r->head.load(std::memory_order_acquire);
+      std::size_t tail = r->tail.load(std::memory_order_acquire);
+      stats.retired += tail;
+      stats.reclaimed += head;
+      stats.pending += tail - head;
+      stats.inline_deletes += r->inline_deletes.load(std::memory_order_relaxed);
+    }
+    stats.max_pending = max_pending_.load(std::memory_order_relaxed);
+    stats.last_sweep_ns = last_sweep_ns_.load(std::memory_order_relaxed);
+    stats.max_latency_ns = max_latency_ns_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+ private:
+  Reclaimer() = default;
+
+  struct Entry {
+    void* p;
+    void (*deleter)(void*);
+  };
+
+  /* The owning thread's end and the sweeper's end sit on separate lines */
+  struct alignas(64) Ring {
+    std::atomic<std::size_t> tail {0};
+    std::size_t cached_head = 0; // Owner's last look at head
+    std::atomic<std::size_t> inline_deletes {0};
+    std::atomic<bool> used {true}; // ThreadRecordList bookkeeping
+    Ring* next = nullptr;
+
+    alignas(64) std::atomic<std::size_t> head {0};
+
+    Entry slots[kRingSize];
+  };
+
+  struct Local {
+    Ring* ring = nullptr;
+    bool exited = false;
+
+    ~Local() {
+      if (ring != nullptr) {
+        ThreadRecordList<Ring>::Release(ring);
+        ring = nullptr;
+      }
+      exited = true;
+    }
+  };
+
+  static Local &ThreadLocal() {
+    thread_local Local local;
+    return local;
+  }
+
+  /* Background thread */
+  void Run() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (true) {
+      wake_.wait_for(lock, kSweepInterval);
+      lock.unlock();
+      Sweep();
+      lock.lock();
+    }
+  }
+
+  /* Destroys everything queued when each ring is reached; returns how many.
+     Moves head along every so often so a busy owner sees room early. */
+  std::size_t Sweep() {
+    std::lock_guard<std::mutex> lock(sweep_mutex_);
+    auto start = std::chrono::steady_clock::now();
+    std::size_t pending {0};
+    std::size_t freed {0};
+    for (Ring* r = rings_.head(); r != nullptr; r = r->next) {
+      std::size_t head = r->head.load(std::memory_order_relaxed);
+      std::size_t tail = r->tail.load(std::memory_order_acquire);
+      pending += tail - head;
+      while (head != tail) {
+        Entry entry = r->slots[head % kRingSize];
+        entry.deleter(entry.p);
+        if (++head % 256 == 0) {
+          r->head.store(head, std::memory_order_release);
+        }
+        freed++;
+      }
+      r->head.store(head, std::memory_order_release);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    if (pending > max_pending_.load(std::memory_order_relaxed)) {
+      max_pending_.store(pending, std::memory_order_relaxed);
+    }
+    if (freed != 0) {
+      last_sweep_ns_.store(Nanoseconds(end - start), std::memory_order_relaxed);
+      // Anything freed now was pushed after the previous sweep read its ring
+      std::uint64_t latency = Nanoseconds(end - last_sweep_start_);
+      if (latency > max_latency_ns_.load(std::memory_order_relaxed)) {
+        max_latency_ns_.store(latency, std::memory_order_relaxed);
+      }
+    }
+    last_sweep_start_ = start;
+    return freed;
+  }
+
+  static std::uint64_t Nanoseconds(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+  }
+
+  ThreadRecordList<Ring> rings_;
+  std::once_flag started_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::mutex sweep_mutex_; // One sweeper at a time: the background thread or Flush
+  std::chrono::steady_clock::time_point last_sweep_start_ = std::chrono::steady_clock::now();
+  std::atomic<std::size_t> max_pending_ {0};
+  std::atomic<std::uint64_t> last_sweep_ns_ {0};
+  std::atomic<std::uint64_t> max_latency_ns_ {0};
+};
+
+} // namespace detail
+
+/* Deleter that queues the object for a background thread to destroy, so
+   dropping a UniquePtr<T, deferred_delete<T>> on a latency critical thread
+   costs a push instead of T's destructors and frees. Stateless, so the
+   pointer stays 8 bytes. Destruction happens later and on another thread:
+   T's destructor must not need the dropping thread or anything it frees
+   right after. Objects still queued at exit are not destroyed; call
+   flush_deferred_deletes() at shutdown. */
+template <typename T>
+struct deferred_delete {
+  deferred_delete() = default;
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  deferred_delete(const deferred_delete<U> &) {}
+
+  void operator()(T* ptr) const {
+    detail::Reclaimer::Instance().Retire(ptr, &Destroy);
+  }
+
+ private:
+  static void Destroy(void* p) {
+    delete static_cast<T*>(p);
+  }
+};
+
+template <typename T>
+struct deferred_delete<T[]> {
+  void operator()(T* ptr) const {
+    detail::Reclaimer::Instance().Retire(ptr, &Destroy);
+  }
+
+ private:
+  static void Destroy(void* p) {
+    delete[] static_cast<T*>(p);
+  }
+};
+
+/* Destroys, on the calling thread, everything deferred so far */
+inline void flush_deferred_deletes() {
+  detail::Reclaimer::Instance().Flush();
+}
+
+inline ReclaimStats deferred_delete_stats() {
+  return detail::Reclaimer::Instance().Stats();
+}
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,245 @@
+/*
+   Pointer sized shared ownership through a count kept in the object
+*/
+
+#ifndef MY_INTRUSIVE_PTR_H
+#define MY_INTRUSIVE_PTR_H
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../MyVector/MyVector.h"
+#include "RefCount.h"
+#include "UniquePtr.h"
+
+namespace my {
+
+/* Base giving a class the add_ref/release hooks IntrusivePtr uses, with
+   the count kept by Policy (AtomicCount or LocalCount). A new object starts
+   at 0; the first IntrusivePtr takes it to 1. Copying the object does not
+   copy the count. Has no virtual destructor: an IntrusivePtr<Base> to a
+   Derived needs Base to declare one, as with UniquePtr. */
+template <typename Policy = AtomicCount>
+class RefCounted {
+ public:
+  void add_ref() const { Policy::Increment(count_); }
+
+  /* True when that was the last reference; the caller then destroys */
+  bool release() const { return Policy::Decrement(count_) == 0; }
+
+  long use_count() const { return Policy::Load(count_); }
+
+ protected:
+  RefCounted() : count_(0) {}
+  RefCounted(const RefCounted &) : count_(0) {}
+  RefCounted &operator=(const RefCounted &) { return *this; }
+  ~RefCounted() = default;
+
+ private:
+  mutable typename Policy::Count count_;
+};
+
+namespace detail {
+
+/* release() either returns whether the object must now be destroyed, and
+   IntrusivePtr deletes it, or returns nothing and destroys it itself */
+template <typename T>
+constexpr bool kReleaseReportsLast = std::is_same<decltype(std::declval<T&>().release()), bool>::value;
+
+template <typename T>
+void ReleaseRef(T* p) {
+  if constexpr (kReleaseReportsLast<T>) {
+    if (p->release()) {
+      delete p;
+    }
+  } else {
+    p->release();
+  }
+}
+
+} // namespace detail
+
+/* Shared ownership of a T that counts its own references: any T with
+   add_ref() and release() members, usually through RefCounted. Only the
+   object pointer is stored, so the pointer is 8 bytes and a count change
+   touches the object's own cache line and nothing else. */
+template <typename T>
+class IntrusivePtr {
+ public:
+  using ValueType = T;
+  using PointerType = ValueType*;
+
+ public:
+  /* Constructors */
+
+  IntrusivePtr() = default;
+
+  IntrusivePtr(std::nullptr_t) {}
+
+  /* Shares p. With add_ref false, adopts a reference the caller already
+     holds, such as one given up by detach(). */
+  explicit IntrusivePtr(PointerType p, bool add_ref = true)
+    : ptr_(p) {
+    if (ptr_ != nullptr && add_ref) {
+      ptr_->add_ref();
+    }
+  }
+
+  /* Adopts the object of a UniquePtr with the default deleter */
+  template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  IntrusivePtr(UniquePtr<U> &&rhs)
+    : IntrusivePtr(rhs.release()) {}
+
+  IntrusivePtr(const IntrusivePtr &rhs)
+    : IntrusivePtr(rhs.ptr_) {}
+
+  IntrusivePtr(IntrusivePtr &&rhs) noexcept
+    : ptr_(rhs.ptr_) {
+    rhs.ptr_ = nullptr;
+  }
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  IntrusivePtr(const IntrusivePtr<U> &rhs)
+    : IntrusivePtr(rhs.get()) {}
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  IntrusivePtr(IntrusivePtr<U> &&rhs)
+    : ptr_(rhs.detach()) {}
+
+  ~IntrusivePtr() {
+    if (ptr_ != nullptr) {
+      detail::ReleaseRef(ptr_);
+    }
+  }
+
+  IntrusivePtr &operator=(const IntrusivePtr &rhs) {
+    IntrusivePtr(rhs).swap(*this);
+    return *this;
+  }
+
+  IntrusivePtr &operator=(IntrusivePtr &&rhs) noexcept {
+    IntrusivePtr(std::move(rhs)).swap(*this);
+    return *this;
+  }
+
+  IntrusivePtr &operator=(std::nullptr_t) {
+    reset();
+    return *this;
+  }
+
+  /* Modifiers */
+
+  void reset(PointerType p = nullptr) {
+    IntrusivePtr(p).swap(*this);
+  }
+
+  void swap(IntrusivePtr &other) noexcept {
+    std::swap(ptr_, other.ptr_);
+  }
+
+  /* Gives up the pointer without releasing its reference, which the caller
+     now holds */
+  PointerType detach() {
+    PointerType p = ptr_;
+    ptr_ = nullptr;
+    return p;
+  }
+
+  /* Moves the object into a UniquePtr. Only for the last reference: throws
+     std::logic_error, and keeps the object, while others share it. */
+  UniquePtr<T> release_unique() {
+    static_assert(detail::kReleaseReportsLast<T>, "release_unique needs a release() reporting the last reference");
+    if (ptr_ == nullptr) {
+      return UniquePtr<T>();
+    }
+    if (ptr_->use_count() != 1) {
+      throw std::logic_error("IntrusivePtr::release_unique on a shared object");
+    }
+    ptr_->release(); // Back to 0, as if never shared
+    return UniquePtr<T>(detach());
+  }
+
+  /* Observers */
+
+  PointerType get() const {
+    return ptr_;
+  }
+
+  T& operator*() const {
+    return *ptr_;
+  }
+
+  PointerType operator->() const {
+    return ptr_;
+  }
+
+  explicit operator bool() const {
+    return ptr_ != nullptr;
+  }
+
+  friend std::ostream& operator<<(std::ostream &os, const IntrusivePtr &ptr) {
+    return os << ptr.get();
+  }
+
+ private:
+  PointerType ptr_ = nullptr;
+};
+
+/* Comparison operators */
+
+template <typename T, typename U>
+bool operator==(const IntrusivePtr<T> &lhs, const IntrusivePtr<U> &rhs) {
+  return lhs.get() == rhs.get();
+}
+
+template <typename T, typename U>
+bool operator!=(const IntrusivePtr<T> &lhs, const IntrusivePtr<U> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T, typename U>
+bool operator<(const IntrusivePtr<T> &lhs, const IntrusivePtr<U> &rhs) {
+  return std::less<const void*>()(lhs.get(), rhs.get());
+}
+
+template <typename T>
+bool operator==(const IntrusivePtr<T> &lhs, std::nullptr_t) {
+  return !lhs;
+}
+
+template <typename T>
+bool operator!=(const IntrusivePtr<T> &lhs, std::nullptr_t) {
+  return static_cast<bool>(lhs);
+}
+
+template <typename T, typename... Args>
+IntrusivePtr<T> make_intrusive(Args&&... args) {
+  return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+/* Drops every reference in v and empties it. Walks the objects in order,
+   prefetching the counts a few elements ahead, since on a large batch each
+   count is a cache miss and clear() would take them one at a time. */
+template <typename T>
+void release_all(MyVector<IntrusivePtr<T>> &v) {
+  constexpr std::size_t kAhead = 8;
+  IntrusivePtr<T>* items = v.data();
+  std::size_t n = v.size();
+  for (std::size_t i {0}; i < n; i++) {
+    if (i + kAhead < n && items[i + kAhead]) {
+      __builtin_prefetch(items[i + kAhead].get(), 1);
+    }
+    if (T* p = items[i].detach()) {
+      detail::ReleaseRef(p);
+    }
+  }
+  v.clear(); // Only empty pointers left to reset
+}
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,396 @@
+/*
+   Pool of constructed objects that UniquePtr hands back instead of
+   destroying
+*/
+
+#ifndef MY_OBJECT_POOL_H
+#define MY_OBJECT_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../MyVector/MyVector.h"
+#include "UniquePtr.h"
+
+namespace my {
+
+template <typename T>
+class ObjectPool;
+
+/* Counters of an ObjectPool */
+struct PoolStats {
+  std::size_t hits = 0;      // acquire() served by a pooled object
+  std::size_t misses = 0;    // acquire() that had to construct one
+  std::size_t returns = 0;   // Objects given back
+  std::size_t discarded = 0; // Given back but destroyed, the pool being full
+  std::size_t idle = 0;      // Pooled right now, shared and in thread caches
+
+  double hit_rate() const {
+    return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses);
+  }
+};
+
+namespace detail {
+
+template <typename T, typename = void>
+struct HasReset : std::false_type {};
+
+template <typename T>
+struct HasReset<T, std::void_t<decltype(std::declval<T&>().reset())>> : std::true_type {};
+
+template <typename T>
+void CallReset(T &object) {
+  object.reset();
+}
+
+/* Ids of the pools alive, so an exiting thread only hands its caches back
+   to pools that still exist. Shared by pools of every type. */
+struct PoolRegistry {
+  std::mutex mutex;
+  MyVector<std::uint64_t> live;
+  std::uint64_t next_id = 1;
+
+  static PoolRegistry &Instance() {
+    static PoolRegistry* registry = new PoolRegistry(); // Never destroyed, threads may exit after main
+    return *registry;
+  }
+
+  std::uint64_t Add() {
+    std::lock_guard<std::mutex> lock(mutex);
+    live.push_back(next_id);
+    return next_id++;
+  }
+
+  void Remove(std::uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::size_t i {0}; i < live.size(); i++) {
+      if (live[i] == id) {
+        live[i] = live[live.size() - 1];
+        live.pop_back();
+        return;
+      }
+    }
+  }
+
+  /* Call with mutex held */
+  bool Alive(std::uint64_t id) const {
+    for (std::size_t i {0}; i < live.size(); i++) {
+      if (live[i] == id) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+} // namespace detail
+
+/* Deleter for ObjectPool objects: gives the object back to the pool it
+   came from, unchanged but for the pool's reset hook. Stateless, so the
+   pointer stays 8 bytes; the pool is found just before the object. */
+template <typename T>
+struct pool_return {
+  void operator()(T* ptr) const {
+    ObjectPool<T>::Return(ptr);
+  }
+};
+
+/* Keeps objects that are costly to build, such as ones holding MyVector
+   buffers, alive between uses. acquire() hands out a pooled object, or
+   default constructs one when none is left; dropping the UniquePtr calls
+   the reset hook and keeps the object, capacity and all. So once the pool
+   is warm, acquire and release run no constructor, destructor or
+   allocation.
+
+   Each thread keeps up to kThreadCache objects of its own and moves half
+   of them to or from the shared list, under a lock, when it runs out or
+   over. The shared list holds at most max_idle objects; past that, given
+   back objects are destroyed. A thread's cache goes back to the shared
+   list when the thread exits.
+
+   The reset hook runs on every object given back and must not throw. By
+   default it calls T's reset() member if there is one. The pool must
+   outlive the objects it hands out. */
+template <typename T>
+class ObjectPool {
+ public:
+  using ValueType = T;
+  using PointerType = ValueType*;
+  using ResetHook = void (*)(T&);
+  using Handle = UniquePtr<T, pool_return<T>>;
+
+  static constexpr std::size_t kThreadCache = 32;
+
+ public:
+  explicit ObjectPool(std::size_t max_idle = 1024, ResetHook reset = DefaultReset())
+    : id_(detail::PoolRegistry::Instance().Add()), max_idle_(max_idle), reset_(reset) {
+    shared_.reserve(max_idle_);
+  }
+
+  ObjectPool(const ObjectPool &) = delete;
+  ObjectPool &operator=(const ObjectPool &) = delete;
+
+  /* Every object must have been given back, and no thread may use the
+     pool any more */
+  ~ObjectPool() {
+    detail::PoolRegistry::Instance().Remove(id_);
+    for (std::size_t i {0}; i < shared_.size(); i++) {
+      Destroy(shared_[i]);
+    }
+    for (std::size_t i {0}; i < caches_.size(); i++) {
+      Cache* cache = caches_[i];
+      for (std::size_t j {0}; j < cache->count.load(std::memory_order_relaxed); j++) {
+        Destroy(cache->items[j]);
+      }
+      delete cache;
+    }
+  }
+
+  /* A pooled object, or a new default constructed one */
+  Handle acquire() {
+    Cache &cache = LocalCache();
+    std::size_t count = cache.count.load(std::memory_order_relaxed);
+    if (count == 0) {
+      count = Refill(cache);
+    }
+    if (count != 0) {
+      Bump(cache.hits);
+      cache.count.store(count - 1, std::memory_order_relaxed);
+      return Handle(cache.items[count - 1]->object());
+    }
+    Bump(cache.misses);
+    return Handle(Make());
+  }
+
+  /* Constructs objects until n are pooled, up to max_idle */
+  void reserve(std::size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (shared_.size() < n && shared_.size() < max_idle_) {
+      shared_.push_back(Slot::Of(Make()));
+    }
+  }
+
+  PoolStats stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PoolStats stats;
+    stats.idle = shared_.size();
+    for (std::size_t i {0}; i < caches_.size(); i++) {
+      const Cache* cache = caches_[i];
+      stats.hits += cache->hits.load(std::memory_order_relaxed);
+      stats.misses += cache->misses.load(std::memory_order_relaxed);
+      stats.returns += cache->returns.load(std::memory_order_relaxed);
+      stats.discarded += cache->discarded.load(std::memory_order_relaxed);
+      stats.idle += cache->count.load(std::memory_order_relaxed);
+    }
+    return stats;
+  }
+
+  /* Called by pool_return */
+  static void Return(PointerType p) {
+    Slot::Of(p)->pool->Give(p);
+  }
+
+ private:
+  /* The pool pointer sits just before the object */
+  struct Slot {
+    ObjectPool* pool;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    PointerType object() { return reinterpret_cast<PointerType>(storage); }
+
+    static Slot* Of(PointerType p) {
+      return reinterpret_cast<Slot*>(reinterpret_cast<unsigned char*>(p) - offsetof(Slot, storage));
+    }
+  };
+
+  /* One thread's objects. Only that thread touches items and writes the
+     counters, so they are plain loads and stores; stats() reads them from
+     any thread. Handed to another thread once the owner exits. */
+  struct alignas(64) Cache {
+    Slot* items[kThreadCache];
+    std::atomic<std::size_t> count {0};
+    std::atomic<std::size_t> hits {0};
+    std::atomic<std::size_t> misses {0};
+    std::atomic<std::size_t> returns {0};
+    std::atomic<std::size_t> discarded {0};
+    bool used = true; // Guarded by the pool's mutex
+  };
+
+  /* The calling thread's caches, one per pool it used */
+  struct ThreadCaches {
+    struct Entry {
+      std::uint64_t id;
+      ObjectPool* pool;
+      Cache* cache;
+    };
+
+    MyVector<Entry> entries;
+    std::uint64_t last_id = 0;
+    Cache* last = nullptr;
+
+    /* Forgets the caches of pools destroyed since, so a long lived thread
+       using many short lived pools does not pile them up */
+    void Prune() {
+      detail::PoolRegistry &registry = detail::PoolRegistry::Instance();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      std::size_t kept {0};
+      for (std::size_t i {0}; i < entries.size(); i++) {
+        if (registry.Alive(entries[i].id)) {
+          entries[kept++] = entries[i];
+        }
+      }
+      while (entries.size() > kept) {
+        entries.pop_back();
+      }
+    }
+
+    ~ThreadCaches() {
+      detail::PoolRegistry &registry = detail::PoolRegistry::Instance();
+      std::lock_guard<std::mutex> lock(registry.mutex); // Keeps the pools from going away meanwhile
+      for (std::size_t i {0}; i < entries.size(); i++) {
+        if (registry.Alive(entries[i].id)) {
+          entries[i].pool->Detach(entries[i].cache);
+        }
+      }
+    }
+  };
+
+  static ResetHook DefaultReset() {
+    if constexpr (detail::HasReset<T>::value) {
+      return &detail::CallReset<T>;
+    } else {
+      return nullptr;
+    }
+  }
+
+  static void Bump(std::atomic<std::size_t> &counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  static void Destroy(Slot* slot) {
+    slot->object()->~T();
+    delete slot;
+  }
+
+  PointerType Make() {
+    Slot* slot = new Slot;
+    slot->pool = this;
+    try {
+      return ::new (static_cast<void*>(slot->storage)) T();
+    } catch (...) {
+      delete slot;
+      throw;
+    }
+  }
+
+  Cache &LocalCache() {
+    thread_local ThreadCaches caches;
+    if (caches.last_id == id_) {
+      return *caches.last;
+    }
+    Cache* cache = nullptr;
+    for (std::size_t i {0}; i < caches.entries.size(); i++) {
+      if (caches.entries[i].id == id_) {
+        cache = caches.entries[i].cache;
+        break;
+      }
+    }
+    if (cache == nullptr) {
+      cache = Attach();
+      caches.Prune();
+      caches.entries.push_back(typename ThreadCaches::Entry {id_, this, cache});
+    }
+    caches.last_id = id_;
+    caches.last = cache;
+    return *cache;
+  }
+
+  /* Takes over the cache of an exited thread, or makes one */
+  Cache* Attach() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i {0}; i < caches_.size(); i++) {
+      if (!caches_[i]->used) {
+        caches_[i]->used = true;
+        return caches_[i];
+      }
+    }
+    caches_.push_back(new Cache());
+    return caches_[caches_.size() - 1];
+  }
+
+  /* The owning thread exited: its objects go to the shared list */
+  void Detach(Cache* cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t count = cache->count.load(std::memory_order_relaxed);
+    while (count > 0) {
+      PutShared(*cache, cache->items[--count]);
+    }
+    cache->count.store(0, std::memory_order_relaxed);
+    cache->used = false;
+  }
+
+  void Give(PointerType p) {
+    if (reset_ != nullptr) {
+      reset_(*p);
+    }
+    Cache &cache = LocalCache();
+    Bump(cache.returns);
+    std::size_t count = cache.count.load(std::memory_order_relaxed);
+    if (count == kThreadCache) {
+      count = Spill(cache);
+    }
+    cache.items[count] = Slot::Of(p);
+    cache.count.store(count + 1, std::memory_order_relaxed);
+  }
+
+  /* Moves up to half a cache from the shared list; returns the new count */
+  std::size_t Refill(Cache &cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t count {0};
+    while (count < kThreadCache / 2 && shared_.size() > 0) {
+      cache.items[count++] = shared_[shared_.size() - 1];
+      shared_.pop_back();
+    }
+    cache.count.store(count, std::memory_order_relaxed);
+    return count;
+  }
+
+  /* Moves the older half of a full cache to the shared list */
+  std::size_t Spill(Cache &cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    constexpr std::size_t kHalf = kThreadCache / 2;
+    for (std::size_t i {0}; i < kHalf; i++) {
+      PutShared(cache, cache.items[i]);
+    }
+    for (std::size_t i {kHalf}; i < kThreadCache; i++) {
+      cache.items[i - kHalf] = cache.items[i];
+    }
+    return kThreadCache - kHalf;
+  }
+
+  /* Call with mutex_ held */
+  void PutShared(Cache &cache, Slot* slot) {
+    if (shared_.size() < max_idle_) {
+      shared_.push_back(slot);
+    } else {
+      Bump(cache.discarded);
+      Destroy(slot);
+    }
+  }
+
+  const std::uint64_t id_;
+  const std::size_t max_idle_;
+  const ResetHook reset_;
+  mutable std::mutex mutex_; // Guards shared_ and caches_
+  MyVector<Slot*> shared_;
+  MyVector<Cache*> caches_;
+};
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,57 @@
+/*
+   Reference count policies shared by SharedPtr and IntrusivePtr
+*/
+
+#ifndef MY_REF_COUNT_H
+#define MY_REF_COUNT_H
+
+#include <atomic>
+
+namespace my {
+
+/* Reference count policies. AtomicCount may be shared between threads like
+   std::shared_ptr; LocalCount uses plain integers, so copies cost no locked
+   instructions, but every pointer to an object must then stay on one
+   thread. */
+struct AtomicCount {
+  using Count = std::atomic<long>;
+
+  static void Increment(Count &c) { c.fetch_add(1, std::memory_order_relaxed); }
+
+  /* Returns the count left. Acquire and release, so the last owner sees
+     every write made through the other owners before it destroys. */
+  static long Decrement(Count &c) { return c.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+
+  static bool IncrementIfNonZero(Count &c) {
+    long n = c.load(std::memory_order_relaxed);
+    while (n != 0) {
+      if (c.compare_exchange_weak(n, n + 1, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static long Load(const Count &c) { return c.load(std::memory_order_acquire); }
+};
+
+struct LocalCount {
+  using Count = long;
+
+  static void Increment(Count &c) { c++; }
+  static long Decrement(Count &c) { return --c; }
+
+  static bool IncrementIfNonZero(Count &c) {
+    if (c == 0) {
+      return false;
+    }
+    c++;
+    return true;
+  }
+
+  static long Load(const Count &c) { return c; }
+};
+
+} // Namespace bracket
+
+#endif
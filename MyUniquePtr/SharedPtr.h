@@ -0,0 +1,485 @@
+/*
+   My implementation of the STL's std::shared_ptr and std::weak_ptr, with
+   the reference counting made a policy
+*/
+
+#ifndef MY_SHARED_PTR_H
+#define MY_SHARED_PTR_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "CompressedPair.h"
+#include "RefCount.h"
+#include "UniquePtr.h"
+
+namespace my {
+
+template <typename T, typename Policy>
+class SharedPtr;
+
+template <typename T, typename Policy>
+class WeakPtr;
+
+namespace detail {
+
+struct SharedAccess;
+
+/* Counts shared by every SharedPtr and WeakPtr to one object. The owners
+   together hold one weak reference, so the block goes away with the last
+   weak reference after the object went with the last strong one. */
+template <typename Policy>
+class ControlBlock {
+ public:
+  ControlBlock() : strong_(1), weak_(1) {}
+
+  ControlBlock(const ControlBlock &) = delete;
+  ControlBlock &operator=(const ControlBlock &) = delete;
+
+  void AddRef() { Policy::Increment(strong_); }
+
+  void Release() {
+    if (Policy::Decrement(strong_) == 0) {
+      Dispose();
+      if (Policy::Load(weak_) == 1) { // No WeakPtr left to race with, skip the decrement
+        Destroy();
+      } else {
+        ReleaseWeak();
+      }
+    }
+  }
+
+  void AddWeak() { Policy::Increment(weak_); }
+
+  void ReleaseWeak() {
+    if (Policy::Decrement(weak_) == 0) {
+      Destroy();
+    }
+  }
+
+  /* For WeakPtr::lock: a strong reference unless the object is gone */
+  bool TryAddRef() { return Policy::IncrementIfNonZero(strong_); }
+
+  long UseCount() const { return Policy::Load(strong_); }
+
+ protected:
+  virtual ~ControlBlock() = default;
+
+ private:
+  virtual void Dispose() = 0; // Destroys the object
+  virtual void Destroy() = 0; // Frees the block
+
+  typename Policy::Count strong_;
+  typename Policy::Count weak_;
+};
+
+/* Block for an object allocated on its own, freed through a deleter */
+template <typename U, typename Deleter, typename Policy>
+class PointerBlock final : public ControlBlock<Policy> {
+ public:
+  PointerBlock(U* p, Deleter d) : storage_(p, std::move(d)) {}
+
+ private:
+  void Dispose() override { storage_.second()(storage_.first()); }
+  void Destroy() override { delete this; }
+
+  CompressedPair<U*, Deleter> storage_;
+};
+
+/* Block with the object inside it, for make_shared's single allocation */
+template <typename T, typename Policy>
+class InplaceBlock final : public ControlBlock<Policy> {
+ public:
+  template <typename... Args>
+  explicit InplaceBlock(Args&&... args) {
+    ::new (static_cast<void*>(&storage_)) T(std::forward<Args>(args)...);
+  }
+
+  T* Object() { return std::launder(reinterpret_cast<T*>(&storage_)); }
+
+ private:
+  void Dispose() override { Object()->~T(); }
+  void Destroy() override { delete this; }
+
+  std::aligned_storage_t<sizeof(T), alignof(T)> storage_;
+};
+
+} // namespace detail
+
+/* Shared ownership of an object through a reference counted control block.
+   Policy is AtomicCount (the default, thread safe like std::shared_ptr) or
+   LocalCount (plain counts for single threaded code). */
+template <typename T, typename Policy = AtomicCount>
+class SharedPtr {
+ public:
+  using ValueType = T;
+  using PointerType = ValueType*;
+
+ public:
+  /* Constructors */
+
+  SharedPtr() = default;
+
+  SharedPtr(std::nullptr_t) {}
+
+  /* Takes ownership of p, deleted with delete */
+  template <typename U>
+  explicit SharedPtr(U* p)
+    : SharedPtr(p, my::default_delete<U>()) {}
+
+  /* Takes ownership of p, freed with d(p) */
+  template <typename U, typename Deleter>
+  SharedPtr(U* p, Deleter d)
+    : ptr_(p) {
+    try {
+      block_ = new detail::PointerBlock<U, Deleter, Policy>(p, d);
+    } catch (...) {
+      d(p);
+      throw;
+    }
+  }
+
+  SharedPtr(const SharedPtr &rhs)
+    : ptr_(rhs.ptr_), block_(rhs.block_) {
+    if (block_ != nullptr) {
+      block_->AddRef();
+    }
+  }
+
+  SharedPtr(SharedPtr &&rhs) noexcept
+    : ptr_(rhs.ptr_), block_(rhs.block_) {
+    rhs.ptr_ = nullptr;
+    rhs.block_ = nullptr;
+  }
+
+  /* From a SharedPtr to a derived type */
+  template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  SharedPtr(const SharedPtr<U, Policy> &rhs)
+    : ptr_(rhs.ptr_), block_(rhs.block_) {
+    if (block_ != nullptr) {
+      block_->AddRef();
+    }
+  }
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  SharedPtr(SharedPtr<U, Policy> &&rhs)
+    : ptr_(rhs.ptr_), block_(rhs.block_) {
+    rhs.ptr_ = nullptr;
+    rhs.block_ = nullptr;
+  }
+
+  /* Aliasing constructor: shares ownership with owner but points at p,
+     typically a member or element of owner's object */
+  template <typename U>
+  SharedPtr(const SharedPtr<U, Policy> &owner, PointerType p)
+    : ptr_(p), block_(owner.block_) {
+    if (block_ != nullptr) {
+      block_->AddRef();
+    }
+  }
+
+  template <typename U>
+  SharedPtr(SharedPtr<U, Policy> &&owner, PointerType p)
+    : ptr_(p), block_(owner.block_) {
+    owner.ptr_ = nullptr;
+    owner.block_ = nullptr;
+  }
+
+  /* Takes over a UniquePtr's object and deleter */
+  template <typename U, typename Deleter,
+            typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  SharedPtr(UniquePtr<U, Deleter> &&rhs) {
+    if (rhs.get() != nullptr) {
+      block_ = new detail::PointerBlock<U, Deleter, Policy>(rhs.get(), std::move(rhs.get_deleter()));
+      ptr_ = rhs.release();
+    }
+  }
+
+  /* From a WeakPtr; throws std::bad_weak_ptr if the object is gone */
+  template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  explicit SharedPtr(const WeakPtr<U, Policy> &rhs)
+    : ptr_(rhs.ptr_), block_(rhs.block_) {
+    if (block_ == nullptr || !block_->TryAddRef()) {
+      throw std::bad_weak_ptr();
+    }
+  }
+
+  ~SharedPtr() {
+    if (block_ != nullptr) {
+      block_->Release();
+    }
+  }
+
+  SharedPtr &operator=(const SharedPtr &rhs) {
+    SharedPtr(rhs).swap(*this);
+    return *this;
+  }
+
+  SharedPtr &operator=(SharedPtr &&rhs) noexcept {
+    SharedPtr(std::move(rhs)).swap(*this);
+    return *this;
+  }
+
+  template <typename U>
+  SharedPtr &operator=(const SharedPtr<U, Policy> &rhs) {
+    SharedPtr(rhs).swap(*this);
+    return *this;
+  }
+
+  template <typename U>
+  SharedPtr &operator=(SharedPtr<U, Policy> &&rhs) {
+    SharedPtr(std::move(rhs)).swap(*this);
+    return *this;
+  }
+
+  template <typename U, typename Deleter>
+  SharedPtr &operator=(UniquePtr<U, Deleter> &&rhs) {
+    SharedPtr(std::move(rhs)).swap(*this);
+    return *this;
+  }
+
+  /* Modifiers */
+
+  void reset() {
+    SharedPtr().swap(*this);
+  }
+
+  template <typename U>
+  void reset(U* p) {
+    SharedPtr(p).swap(*this);
+  }
+
+  template <typename U, typename Deleter>
+  void reset(U* p, Deleter d) {
+    SharedPtr(p, d).swap(*this);
+  }
+
+  void swap(SharedPtr &other) noexcept {
+    std::swap(ptr_, other.ptr_);
+    std::swap(block_, other.block_);
+  }
+
+  /* Observers */
+
+  PointerType get() const {
+    return ptr_;
+  }
+
+  T& operator*() const {
+    return *ptr_;
+  }
+
+  PointerType operator->() const {
+    return ptr_;
+  }
+
+  long use_count() const {
+    return block_ != nullptr ? block_->UseCount() : 0;
+  }
+
+  explicit operator bool() const {
+    return ptr_ != nullptr;
+  }
+
+  /* Orders by control block, so aliases of one object compare equivalent */
+  template <typename U>
+  bool owner_before(const SharedPtr<U, Policy> &rhs) const {
+    return block_ < rhs.block_;
+  }
+
+  template <typename U>
+  bool owner_before(const WeakPtr<U, Policy> &rhs) const {
+    return block_ < rhs.block_;
+  }
+
+  friend std::ostream& operator<<(std::ostream &os, const SharedPtr &ptr) {
+    return os << ptr.get();
+  }
+
+ private:
+  template <typename U, typename P>
+  friend class SharedPtr;
+
+  template <typename U, typename P>
+  friend class WeakPtr;
+
+  friend struct detail::SharedAccess;
+
+  /* Adopts a strong reference already counted in block */
+  SharedPtr(PointerType p, detail::ControlBlock<Policy>* block, int)
+    : ptr_(p), block_(block) {}
+
+  PointerType ptr_ = nullptr;
+  detail::ControlBlock<Policy>* block_ = nullptr;
+};
+
+/* Comparison operators */
+
+template <typename T, typename U, typename Policy>
+bool operator==(const SharedPtr<T, Policy> &lhs, const SharedPtr<U, Policy> &rhs) {
+  return lhs.get() == rhs.get();
+}
+
+template <typename T, typename U, typename Policy>
+bool operator!=(const SharedPtr<T, Policy> &lhs, const SharedPtr<U, Policy> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T, typename U, typename Policy>
+bool operator<(const SharedPtr<T, Policy> &lhs, const SharedPtr<U, Policy> &rhs) {
+  return std::less<const void*>()(lhs.get(), rhs.get());
+}
+
+template <typename T, typename Policy>
+bool operator==(const SharedPtr<T, Policy> &lhs, std::nullptr_t) {
+  return !lhs;
+}
+
+template <typename T, typename Policy>
+bool operator!=(const SharedPtr<T, Policy> &lhs, std::nullptr_t) {
+  return static_cast<bool>(lhs);
+}
+
+/* Non-owning reference to an object managed by SharedPtr. lock() gives a
+   SharedPtr if the object still exists. */
+template <typename T, typename Policy = AtomicCount>
+class WeakPtr {
+ public:
+  using ValueType = T;
+  using PointerType = ValueType*;
+
+ public:
+  WeakPtr() = default;
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  WeakPtr(const SharedPtr<U, Policy> &rhs)
+    : ptr_(rhs.ptr_), block_(rhs.block_) {
+    if (block_ != nullptr) {
+      block_->AddWeak();
+    }
+  }
+
+  WeakPtr(const WeakPtr &rhs)
+    : ptr_(rhs.ptr_), block_(rhs.block_) {
+    if (block_ != nullptr) {
+      block_->AddWeak();
+    }
+  }
+
+  WeakPtr(WeakPtr &&rhs) noexcept
+    : ptr_(rhs.ptr_), block_(rhs.block_) {
+    rhs.ptr_ = nullptr;
+    rhs.block_ = nullptr;
+  }
+
+  ~WeakPtr() {
+    if (block_ != nullptr) {
+      block_->ReleaseWeak();
+    }
+  }
+
+  WeakPtr &operator=(const WeakPtr &rhs) {
+    WeakPtr(rhs).swap(*this);
+    return *this;
+  }
+
+  WeakPtr &operator=(WeakPtr &&rhs) noexcept {
+    WeakPtr(std::move(rhs)).swap(*this);
+    return *this;
+  }
+
+  template <typename U>
+  WeakPtr &operator=(const SharedPtr<U, Policy> &rhs) {
+    WeakPtr(rhs).swap(*this);
+    return *this;
+  }
+
+  /* Modifiers */
+
+  void reset() {
+    WeakPtr().swap(*this);
+  }
+
+  void swap(WeakPtr &other) noexcept {
+    std::swap(ptr_, other.ptr_);
+    std::swap(block_, other.block_);
+  }
+
+  /* Observers */
+
+  long use_count() const {
+    return block_ != nullptr ? block_->UseCount() : 0;
+  }
+
+  bool expired() const {
+    return use_count() == 0;
+  }
+
+  /* A SharedPtr to the object, or an empty one if it is gone */
+  SharedPtr<T, Policy> lock() const {
+    if (block_ != nullptr && block_->TryAddRef()) {
+      return SharedPtr<T, Policy>(ptr_, block_, 0);
+    }
+    return SharedPtr<T, Policy>();
+  }
+
+  template <typename U>
+  bool owner_before(const WeakPtr<U, Policy> &rhs) const {
+    return block_ < rhs.block_;
+  }
+
+  template <typename U>
+  bool owner_before(const SharedPtr<U, Policy> &rhs) const {
+    return block_ < rhs.block_;
+  }
+
+ private:
+  template <typename U, typename P>
+  friend class SharedPtr;
+
+  template <typename U, typename P>
+  friend class WeakPtr;
+
+  PointerType ptr_ = nullptr;
+  detail::ControlBlock<Policy>* block_ = nullptr;
+};
+
+namespace detail {
+
+/* Lets make_shared hand its block to a SharedPtr */
+struct SharedAccess {
+  template <typename T, typename Policy>
+  static SharedPtr<T, Policy> Adopt(T* p, ControlBlock<Policy>* block) {
+    return SharedPtr<T, Policy>(p, block, 0);
+  }
+};
+
+} // namespace detail
+
+/* Single threaded aliases */
+template <typename T>
+using LocalSharedPtr = SharedPtr<T, LocalCount>;
+
+template <typename T>
+using LocalWeakPtr = WeakPtr<T, LocalCount>;
+
+/* Builds a T and its control block in one allocation */
+template <typename T, typename Policy = AtomicCount, typename... Args>
+SharedPtr<T, Policy> make_shared(Args&&... args) {
+  auto* block = new detail::InplaceBlock<T, Policy>(std::forward<Args>(args)...);
+  return detail::SharedAccess::Adopt<T, Policy>(block->Object(), block);
+}
+
+template <typename T, typename... Args>
+LocalSharedPtr<T> make_local_shared(Args&&... args) {
+  return make_shared<T, LocalCount>(std::forward<Args>(args)...);
+}
+
+} // Namespace bracket
+
+#endif
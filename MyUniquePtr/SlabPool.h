@@ -0,0 +1,209 @@
+/*
+   Per type, per thread slab pools behind my::make_unique_pooled
+*/
+
+#ifndef MY_SLAB_POOL_H
+#define MY_SLAB_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include "UniquePtr.h"
+
+namespace my {
+
+namespace detail {
+
+/* Slabs are this big and aligned to their size, so the slab of any slot,
+   and through it the owning pool, is found by masking the slot's address */
+inline constexpr std::size_t kSlabBytes = std::size_t(64) << 10;
+
+constexpr std::size_t RoundUpTo(std::size_t n, std::size_t align) {
+  return (n + align - 1) / align * align;
+}
+
+/* One thread's pool of T sized slots. The owning thread allocates and frees
+   without atomics or locks: a free slot is threaded onto a free list
+   through its own first bytes, and fresh slots are carved off the newest
+   slab. Another thread freeing a slot pushes it onto the pool's remote free
+   list, an atomic stack the owner takes over whole once its own list runs
+   dry.
+
+   Pools are never destroyed, since a slot may be freed long after its
+   thread exited. Instead the pool of an exited thread is parked, and the
+   next thread that needs a pool of this type adopts it, slabs, free lists
+   and all. So the memory held is bounded by the peak number of threads
+   using T at once, and slabs are reused but never handed back. */
+template <typename T>
+class SlabPool {
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  /* Start of every slab */
+  struct Slab {
+    SlabPool* owner;
+  };
+
+  static constexpr std::size_t kAlign = alignof(T) > alignof(FreeNode) ? alignof(T) : alignof(FreeNode);
+  static constexpr std::size_t kSlotBytes = RoundUpTo(sizeof(T) > sizeof(FreeNode) ? sizeof(T) : sizeof(FreeNode), kAlign);
+  static constexpr std::size_t kFirstSlot = RoundUpTo(sizeof(Slab), kAlign);
+
+  static_assert(kFirstSlot + 16 * kSlotBytes <= kSlabBytes, "make_unique_pooled is for small objects");
+
+ public:
+  /* The calling thread's pool, adopting a parked one or making one first */
+  static SlabPool &Current() {
+    ThreadSlot &slot = Slot();
+    if (slot.pool == nullptr) {
+      slot.pool = Adopt();
+    }
+    return *slot.pool;
+  }
+
+  /* Uninitialized storage for one T */
+  void* Allocate() {
+    if (free_ == nullptr) {
+      free_ = remote_.exchange(nullptr, std::memory_order_acquire);
+      if (free_ == nullptr) {
+        return Carve();
+      }
+    }
+    FreeNode* node = free_;
+    free_ = node->next;
+    return node;
+  }
+
+  /* Gives back storage from Allocate, on any thread */
+  static void Free(void* p) {
+    Slab* slab = reinterpret_cast<Slab*>(reinterpret_cast<std::uintptr_t>(p) & ~(kSlabBytes - 1));
+    SlabPool* owner = slab->owner;
+    FreeNode* node = static_cast<FreeNode*>(p);
+    if (owner == Slot().pool) {
+      node->next = owner->free_;
+      owner->free_ = node;
+    } else {
+      owner->PushRemote(node);
+    }
+  }
+
+  /* Slabs this pool has carved so far */
+  std::size_t slabs() const { return slab_count_; }
+
+ private:
+  SlabPool() = default;
+
+  /* Parks the thread's pool when the thread exits */
+  struct ThreadSlot {
+    SlabPool* pool = nullptr;
+
+    ~ThreadSlot() {
+      if (pool != nullptr) {
+        Park(pool);
+        pool = nullptr;
+      }
+    }
+  };
+
+  static ThreadSlot &Slot() {
+    thread_local ThreadSlot slot;
+    return slot;
+  }
+
+  /* Pools of exited threads, linked through next_parked_ */
+  struct Parked {
+    std::mutex mutex;
+    SlabPool* head = nullptr;
+  };
+
+  static Parked &ParkedPools() {
+    static Parked* parked = new Parked(); // Never destroyed, threads may exit after main
+    return *parked;
+  }
+
+  static SlabPool* Adopt() {
+    Parked &parked = ParkedPools();
+    std::lock_guard<std::mutex> lock(parked.mutex);
+    if (parked.head == nullptr) {
+      return new SlabPool();
+    }
+    SlabPool* pool = parked.head;
+    parked.head = pool->next_parked_;
+    pool->next_parked_ = nullptr;
+    return pool;
+  }
+
+  static void Park(SlabPool* pool) {
+    Parked &parked = ParkedPools();
+    std::lock_guard<std::mutex> lock(parked.mutex);
+    pool->next_parked_ = parked.head;
+    parked.head = pool;
+  }
+
+  /* A fresh slot off the newest slab, starting a slab if it is used up */
+  void* Carve() {
+    if (bump_ + kSlotBytes > end_) {
+      char* slab = static_cast<char*>(::operator new(kSlabBytes, std::align_val_t(kSlabBytes)));
+      reinterpret_cast<Slab*>(slab)->owner = this;
+      bump_ = slab + kFirstSlot;
+      end_ = slab + kSlabBytes;
+      slab_count_++;
+    }
+    void* slot = bump_;
+    bump_ += kSlotBytes;
+    return slot;
+  }
+
+  void PushRemote(FreeNode* node) {
+    FreeNode* head = remote_.load(std::memory_order_relaxed);
+    do {
+      node->next = head;
+    } while (!remote_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  FreeNode* free_ = nullptr;
+  char* bump_ = nullptr;
+  char* end_ = nullptr;
+  std::size_t slab_count_ = 0;
+  SlabPool* next_parked_ = nullptr;
+  alignas(64) std::atomic<FreeNode*> remote_ {nullptr}; // Own line, other threads write it
+};
+
+} // namespace detail
+
+/* Deleter for make_unique_pooled: destroys the object and hands its slot
+   back to the pool it came from. Stateless, so the UniquePtr stays one
+   pointer wide. */
+template <typename T>
+struct pool_delete {
+  pool_delete() = default;
+
+  void operator()(T* ptr) const {
+    ptr->~T();
+    detail::SlabPool<T>::Free(ptr);
+  }
+};
+
+/* make_unique for small objects created and destroyed at high rates: the
+   memory comes from the calling thread's slab pool for T instead of
+   operator new. The pointer may be freed on any thread. */
+template <typename T, typename... Args>
+UniquePtr<T, pool_delete<T>> make_unique_pooled(Args&&... args) {
+  void* slot = detail::SlabPool<T>::Current().Allocate();
+  T* p;
+  try {
+    p = new (slot) T(std::forward<Args>(args)...);
+  } catch (...) {
+    detail::SlabPool<T>::Free(slot);
+    throw;
+  }
+  return UniquePtr<T, pool_delete<T>>(p);
+}
+
+} // Namespace bracket
+
+#endif
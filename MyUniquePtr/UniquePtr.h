@@ -2,10 +2,15 @@
    My implementation of the STL's std::unique_ptr
 */
 
+#ifndef MY_UNIQUE_PTR_H
+#define MY_UNIQUE_PTR_H
+
 #include <memory>
 #include <iostream>
 #include <ostream>
 
+#include "CompressedPair.h"
+
 namespace my {
 
 template <typename T>
@@ -33,23 +38,21 @@ class UniquePtr {
 
   /* Default Constructor: assigns ptr to nullptr */
   UniquePtr()
-    : ptr_(nullptr) {
+    : storage_(nullptr) {
     }
 
   /* Creates a UniquePointer based on raw pointer */
   explicit UniquePtr(PointerType p)
-    : ptr_(p) {
+    : storage_(p) {
     }
 
   UniquePtr(PointerType p, Deleter d)
-    : ptr_(p), deleter_(d) {
+    : storage_(p, std::move(d)) {
     }
 
   /* Move constructor: transfers ownership to newly created pointer */
-  UniquePtr(UniquePtr &&u) {
-    ptr_ = std::move(u.get());
-    deleter_ = std::move(u.get_deleter());
-    u = nullptr;
+  UniquePtr(UniquePtr &&u)
+    : storage_(u.release(), std::move(u.get_deleter())) {
   };  
   
   /* Move assignment operator: transfers ownership using '=' */
@@ -57,75 +60,74 @@ class UniquePtr {
     if (*this == u) {
       return *this;
     }
-    ptr_ = std::move(u.get());
-    deleter_ = std::move(u.get_deleter());
-    u = nullptr;
+    reset(u.release());
+    get_deleter() = std::move(u.get_deleter());
     return *this;
   }
 
   /* Destructor */ 
   ~UniquePtr() {
-    if (ptr_ != nullptr) {
-      get_deleter()(ptr_);
+    if (storage_.first() != nullptr) {
+      get_deleter()(storage_.first());
     }
   };
  
   /* Modifiers */
 
   PointerType release() {
-    PointerType p = ptr_;
-    ptr_ = nullptr;
+    PointerType p = storage_.first();
+    storage_.first() = nullptr;
     return p;
   };
 
   void reset(PointerType p = PointerType()) {
-    PointerType tmp = ptr_;
-    ptr_ = p;
+    PointerType tmp = storage_.first();
+    storage_.first() = p;
     if (tmp) {
       get_deleter()(tmp);
     }
   };
 
   void swap(UniquePtr &other) {
-    std::swap(ptr_, other.ptr_);
-    std::swap(deleter_, other.deleter_);
+    std::swap(storage_.first(), other.storage_.first());
+    std::swap(get_deleter(), other.get_deleter());
   };
 
   /* Observers */
 
   PointerType get() const {
-    return ptr_;
+    return storage_.first();
   };
 
-  Deleter& get_deleter() const {
-    return deleter_;
+  const Deleter& get_deleter() const {
+    return storage_.second();
   };
 
   Deleter& get_deleter() {
-    return deleter_;
+    return storage_.second();
   }
 
   explicit operator bool() const {
-    return !(ptr_ == nullptr);
+    return !(storage_.first() == nullptr);
   };
 
   ValueType operator*() const {
-    return *ptr_;
+    return *storage_.first();
   }
 
   PointerType operator->() const {
-    return ptr_;
+    return storage_.first();
   };
 
   /* Comparison operators */
 
   UniquePtr &operator=(std::nullptr_t) {
-    ptr_ = nullptr;
+    reset();
     return *this;
   }
 
   bool operator==(const UniquePtr &rhs) {
-    return (ptr_ == rhs.ptr_);
+    return (storage_.first() == rhs.storage_.first());
   };
 
   bool operator!=(const UniquePtr &rhs) {
@@ -133,7 +135,7 @@ class UniquePtr {
   };
 
   bool operator<(const UniquePtr &rhs) {
-    return ptr_ < rhs.ptr_;
+    return storage_.first() < rhs.storage_.first();
   };
 
   bool operator<=(const UniquePtr &rhs) {
@@ -141,7 +143,7 @@ class UniquePtr {
   };
 
   bool operator>(const UniquePtr &rhs) {
-    return ptr_ > rhs.ptr_;
+    return storage_.first() > rhs.storage_.first();
   };
 
   bool operator>=(const UniquePtr &rhs) {
@@ -154,8 +156,8 @@ class UniquePtr {
   }
 
 private:
-  PointerType ptr_ = nullptr;
-  Deleter deleter_;
+  /* The pointer, and the deleter folded into it when it has no state */
+  detail::CompressedPair<PointerType, Deleter> storage_;
 };
 
 template <typename T, typename... Args>
@@ -192,97 +194,89 @@ class UniquePtr<T[], Deleter> {
 
   /* Default Constructor */
   UniquePtr()
-    :ptr_(nullptr) {}
+    : storage_(nullptr) {}
 
   /* Creates based on raw pointer */
   template <typename U>
   explicit UniquePtr(U p)
-    : ptr_(p) {} 
+    : storage_(p) {} 
 
   template <typename U>
   explicit UniquePtr(U p, Deleter d)
-    : ptr_(p), deleter_(d) {}
+    : storage_(p, std::move(d)) {}
 
   /* Move constructor */
-  UniquePtr(UniquePtr&& u) {
-    ptr_ = std::move(u.get());
-    deleter_ = std::move(u.get_deleter());
-    u = nullptr;
-  }
+  UniquePtr(UniquePtr&& u)
+    : storage_(u.release(), std::move(u.get_deleter())) {}
 
   /* Move assignment operator */
   UniquePtr &operator=(UniquePtr&&u) {
     if (*this == u) {
       return *this;
     }
-    ptr_ = std::move(u.get());
-    deleter_ = std::move(u.get_deleter());
-    u = nullptr;
+    reset(u.release());
+    get_deleter() = std::move(u.get_deleter());
     return *this;
   }
 
   ~UniquePtr() {
-    if (ptr_ != nullptr) {
-      get_deleter()(ptr_);
+    if (storage_.first() != nullptr) {
+      get_deleter()(storage_.first());
     }
   }
 
   /* Modifiers */
 
   PointerType release() {
-    PointerType p = ptr_;
-    ptr_ = nullptr;
+    PointerType p = storage_.first();
+    storage_.first() = nullptr;
     return p;
   }
 
   void reset(PointerType p = PointerType()) {
-    PointerType tmp = ptr_;
-    ptr_ = p;
+    PointerType tmp = storage_.first();
+    storage_.first() = p;
     if (tmp) {
       get_deleter()(tmp);
     }
   }
 
   void swap(UniquePtr &other) {
-    std::swap(ptr_, other.ptr_);
-    std::swap(deleter_, other.deleter_);
+    std::swap(storage_.first(), other.storage_.first());
+    std::swap(get_deleter(), other.get_deleter());
   }
 
   /* Observers */
 
   PointerType get() const {
-    return ptr_;
+    return storage_.first();
   }
 
-  Deleter& get_deleter() const {
-    return deleter_;
+  const Deleter& get_deleter() const {
+    return storage_.second();
   }
 
   Deleter& get_deleter() {
-    return deleter_;
+    return storage_.second();
   }
 
   explicit operator bool() const {
-    return ptr_ != nullptr;
+    return storage_.first() != nullptr;
   }
 
   ValueType& operator[](std::size_t i) const {
-    return ptr_[i];
-  }
-
-  ValueType& operator[](int i) {
-    return ptr_[i];
+    return storage_.first()[i];
   }
 
   /* Comparison Operators */
 
   UniquePtr &operator=(std::nullptr_t) {
-    ptr_ = nullptr;
+    reset();
     return *this;
   }
 
   bool operator==(const UniquePtr &rhs) {
-    return (ptr_ == rhs.ptr_);
+    return (storage_.first() == rhs.storage_.first());
   };
 
   bool operator!=(const UniquePtr &rhs) {
@@ -290,7 +284,7 @@ class UniquePtr<T[], Deleter> {
   };
 
   bool operator<(const UniquePtr &rhs) {
-    return ptr_ < rhs.ptr_;
+    return storage_.first() < rhs.storage_.first();
   };
 
   bool operator<=(const UniquePtr &rhs) {
@@ -298,7 +292,7 @@ class UniquePtr<T[], Deleter> {
   };
 
   bool operator>(const UniquePtr &rhs) {
-    return ptr_ > rhs.ptr_;
+    return storage_.first() > rhs.storage_.first();
   };
 
   bool operator>=(const UniquePtr &rhs) {
@@ -310,8 +304,7 @@ class UniquePtr<T[], Deleter> {
   }
 
  private:
-  PointerType ptr_ = nullptr;
-  Deleter deleter_ = my::default_delete<T[]>();
+  detail::CompressedPair<PointerType, Deleter> storage_;
 };
 
 template <typename T>
@@ -321,3 +314,5 @@ UniquePtr<T> make_unique_array(std::size_t size) {
 }
 
 } // Namespace bracket
+
+#endif
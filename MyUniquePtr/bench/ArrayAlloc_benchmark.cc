@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <benchmark/benchmark.h>
+#include "../ArrayAlloc.h"
+
+// Getting a large I/O buffer ready: allocate state.range(0) bytes, fill
+// them as a read would, drop them. Zeroed is new char[n]();
+// ForOverwrite skips the zeroing; Aligned and Pages use the new
+// allocators. Touch walks an already allocated buffer, 4 KiB pages
+// against huge pages (when the kernel grants them).
+
+static void Fill(char* buf, std::size_t n) {
+  std::memset(buf, 0x5a, n);
+  benchmark::DoNotOptimize(buf);
+  benchmark::ClobberMemory();
+}
+
+static void BM_Zeroed(benchmark::State &state) {
+  std::size_t n = state.range(0);
+  for (auto _ : state) {
+    my::UniquePtr<char[]> buf (new char[n]());
+    Fill(buf.get(), n);
+  }
+  state.SetBytesProcessed(state.iterations() * n);
+}
+
+static void BM_ForOverwrite(benchmark::State &state) {
+  std::size_t n = state.range(0);
+  for (auto _ : state) {
+    auto buf = my::make_unique_for_overwrite<char[]>(n);
+    Fill(buf.get(), n);
+  }
+  state.SetBytesProcessed(state.iterations() * n);
+}
+
+static void BM_Aligned(benchmark::State &state) {
+  std::size_t n = state.range(0);
+  for (auto _ : state) {
+    auto buf = my::make_unique_aligned<char[]>(n, 64);
+    Fill(buf.get(), n);
+  }
+  state.SetBytesProcessed(state.iterations() * n);
+}
+
+static void BM_Pages(benchmark::State &state) {
+  std::size_t n = state.range(0);
+  for (auto _ : state) {
+    auto buf = my::make_unique_pages<char[]>(n);
+    Fill(buf.get(), n);
+  }
+  state.SetBytesProcessed(state.iterations() * n);
+}
+
+// Reads one word per 4 KiB page, in a scattered order, of a filled buffer
+template <typename Make>
+static void Touch(benchmark::State &state, Make make) {
+  std::size_t n = state.range(0) / sizeof(std::uint64_t);
+  auto buf = make(n);
+  std::fill(buf.get(), buf.get() + n, 1);
+  std::size_t pages = n / 512;
+  std::uint64_t sum {0};
+  std::size_t page {0};
+  for (auto _ : state) {
+    page = (page * 1103515245 + 12345) % pages;
+    sum += buf[page * 512];
+  }
+  benchmark::DoNotOptimize(sum);
+}
+
+static void BM_TouchAligned(benchmark::State &state) {
+  Touch(state, [](std::size_t n) { return my::make_unique_aligned<std::uint64_t[]>(n, 64); });
+}
+
+static void BM_TouchPages(benchmark::State &state) {
+  Touch(state, [](std::size_t n) { return my::make_unique_pages<std::uint64_t[]>(n); });
+}
+
+BENCHMARK(BM_Zeroed)->Arg(64 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ForOverwrite)->Arg(64 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Aligned)->Arg(64 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Pages)->Arg(64 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TouchAligned)->Arg(1 << 30);
+BENCHMARK(BM_TouchPages)->Arg(1 << 30);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <benchmark/benchmark.h>
+#include "../AtomicUniquePtr.h"
+
+// Reading the current routing table: my::AtomicUniquePtr::load() against a
+// UniquePtr guarded by a std::mutex or a std::shared_mutex. Each read looks
+// at one field of the table. With state.range(0) set, one writer thread
+// publishes a new table in a loop while the readers run.
+
+struct Table {
+  std::uint64_t version;
+  std::uint64_t routes[7] = {};
+
+  explicit Table(std::uint64_t v) : version(v) {}
+};
+
+struct Atomic {
+  my::AtomicUniquePtr<Table> table {my::make_unique<Table>(0)};
+
+  std::uint64_t Read() {
+    auto guard = table.load();
+    return guard->version;
+  }
+
+  void Write(std::uint64_t v) {
+    table.store(my::make_unique<Table>(v));
+  }
+};
+
+struct Mutex {
+  std::mutex mutex;
+  my::UniquePtr<Table> table {my::make_unique<Table>(0)};
+
+  std::uint64_t Read() {
+    std::lock_guard<std::mutex> lock (mutex);
+    return table->version;
+  }
+
+  void Write(std::uint64_t v) {
+    auto next = my::make_unique<Table>(v);
+    std::lock_guard<std::mutex> lock (mutex);
+    table = std::move(next);
+  }
+};
+
+struct SharedMutex {
+  std::shared_mutex mutex;
+  my::UniquePtr<Table> table {my::make_unique<Table>(0)};
+
+  std::uint64_t Read() {
+    std::shared_lock<std::shared_mutex> lock (mutex);
+    return table->version;
+  }
+
+  void Write(std::uint64_t v) {
+    auto next = my::make_unique<Table>(v);
+    std::unique_lock<std::shared_mutex> lock (mutex);
+    table = std::move(next);
+  }
+};
+
+template <typename Kind>
+static void BM_Read(benchmark::State &state) {
+  Kind kind;
+  std::atomic<bool> done {false};
+  std::thread writer;
+  if (state.range(0) != 0) {
+    writer = std::thread([&]() {
+      for (std::uint64_t v {1}; !done.load(std::memory_order_relaxed); v++) {
+        kind.Write(v);
+        std::this_thread::yield();
+      }
+    });
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kind.Read());
+  }
+  done = true;
+  if (writer.joinable()) {
+    writer.join();
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Read, Atomic)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_Read, Mutex)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_Read, SharedMutex)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <benchmark/benchmark.h>
+#include "../IntrusivePtr.h"
+#include "../SharedPtr.h"
+
+// Reference count churn on shared messages: my::IntrusivePtr against
+// my::SharedPtr built by make_shared, both with atomic and plain counts.
+// Copy makes and drops one copy per iteration of one hot object; Scatter
+// copies random messages out of a pool of state.range(0) (a power of two),
+// so each count change is likely a cache miss; Teardown drops a batch of 1M references
+// through release_all or MyVector::clear.
+//
+// main starts a thread first, as in any pipeline that shares messages.
+
+struct AtomicMessage : my::RefCounted<my::AtomicCount> {
+  std::int64_t payload[4] = {};
+};
+
+struct LocalMessage : my::RefCounted<my::LocalCount> {
+  std::int64_t payload[4] = {};
+};
+
+struct Payload {
+  std::int64_t payload[4] = {};
+};
+
+struct IntrusiveAtomic {
+  using Ptr = my::IntrusivePtr<AtomicMessage>;
+  static Ptr Make() { return my::make_intrusive<AtomicMessage>(); }
+};
+
+struct IntrusiveLocal {
+  using Ptr = my::IntrusivePtr<LocalMessage>;
+  static Ptr Make() { return my::make_intrusive<LocalMessage>(); }
+};
+
+struct SharedAtomic {
+  using Ptr = my::SharedPtr<Payload, my::AtomicCount>;
+  static Ptr Make() { return my::make_shared<Payload, my::AtomicCount>(); }
+};
+
+struct SharedLocal {
+  using Ptr = my::SharedPtr<Payload, my::LocalCount>;
+  static Ptr Make() { return my::make_shared<Payload, my::LocalCount>(); }
+};
+
+template <typename Kind>
+static void BM_Copy(benchmark::State &state) {
+  typename Kind::Ptr p = Kind::Make();
+  for (auto _ : state) {
+    typename Kind::Ptr copy = p;
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Kind>
+static void BM_Scatter(benchmark::State &state) {
+  MyVector<typename Kind::Ptr> pool;
+  for (std::int64_t i {0}; i < state.range(0); i++) {
+    pool.push_back(Kind::Make());
+  }
+  std::uint64_t x {42};
+  std::size_t mask = static_cast<std::size_t>(state.range(0)) - 1;
+  for (auto _ : state) {
+    x = x * 6364136223846793005ull + 1442695040888963407ull;
+    typename Kind::Ptr copy = pool[static_cast<std::size_t>(x >> 33) & mask];
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static constexpr std::int64_t kTeardown = 1 << 20;
+
+// A quarter of the references go to one shared message, and the batch is
+// shuffled, as messages arrive after passing through other stages
+static void Fill(MyVector<my::IntrusivePtr<AtomicMessage>> &batch) {
+  my::IntrusivePtr<AtomicMessage> shared = my::make_intrusive<AtomicMessage>();
+  for (std::int64_t i {0}; i < kTeardown; i++) {
+    batch.push_back(i % 4 == 0 ? shared : my::make_intrusive<AtomicMessage>());
+  }
+  std::shuffle(batch.data(), batch.data() + batch.size(), std::mt19937_64(42));
+}
+
+static void BM_TeardownClear(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    MyVector<my::IntrusivePtr<AtomicMessage>> batch;
+    Fill(batch);
+    state.ResumeTiming();
+    batch.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * kTeardown);
+}
+
+static void BM_TeardownReleaseAll(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    MyVector<my::IntrusivePtr<AtomicMessage>> batch;
+    Fill(batch);
+    state.ResumeTiming();
+    my::release_all(batch);
+  }
+  state.SetItemsProcessed(state.iterations() * kTeardown);
+}
+
+BENCHMARK_TEMPLATE(BM_Copy, IntrusiveAtomic);
+BENCHMARK_TEMPLATE(BM_Copy, SharedAtomic);
+BENCHMARK_TEMPLATE(BM_Copy, IntrusiveLocal);
+BENCHMARK_TEMPLATE(BM_Copy, SharedLocal);
+BENCHMARK_TEMPLATE(BM_Scatter, IntrusiveAtomic)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Scatter, SharedAtomic)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Scatter, IntrusiveLocal)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Scatter, SharedLocal)->Arg(1 << 20);
+BENCHMARK(BM_TeardownClear)->Iterations(10)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TeardownReleaseAll)->Iterations(10)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+  std::thread([]() {}).join();
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
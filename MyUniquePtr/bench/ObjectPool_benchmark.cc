@@ -0,0 +1,73 @@
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include "../ObjectPool.h"
+
+// A message buffer whose MyVector is reserved when it is built: one
+// acquire, fill with 64 values and release per iteration, through
+// my::make_unique (build and destroy every time) or my::ObjectPool (reuse
+// after clear()). Batch keeps state.range(0) buffers out at once, so the
+// pool goes through its shared list.
+
+struct Buffer {
+  MyVector<std::uint64_t> data;
+
+  Buffer() { data.reserve(4096); }
+
+  void reset() { data.clear(); }
+};
+
+static void Fill(Buffer* buf) {
+  for (std::uint64_t i {0}; i < 64; i++) {
+    buf->data.push_back(i);
+  }
+  benchmark::DoNotOptimize(buf->data.data());
+}
+
+static void BM_MakeUnique(benchmark::State &state) {
+  for (auto _ : state) {
+    auto buf = my::make_unique<Buffer>();
+    Fill(buf.get());
+  }
+}
+
+static void BM_Pool(benchmark::State &state) {
+  my::ObjectPool<Buffer> pool;
+  for (auto _ : state) {
+    auto buf = pool.acquire();
+    Fill(buf.get());
+  }
+  state.counters["hit_rate"] = pool.stats().hit_rate();
+}
+
+static void BM_MakeUniqueBatch(benchmark::State &state) {
+  MyVector<my::UniquePtr<Buffer>> batch;
+  for (auto _ : state) {
+    for (std::size_t i {0}; i < static_cast<std::size_t>(state.range(0)); i++) {
+      batch.push_back(my::make_unique<Buffer>());
+      Fill(batch[i].get());
+    }
+    batch.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PoolBatch(benchmark::State &state) {
+  my::ObjectPool<Buffer> pool;
+  MyVector<my::ObjectPool<Buffer>::Handle> batch;
+  for (auto _ : state) {
+    for (std::size_t i {0}; i < static_cast<std::size_t>(state.range(0)); i++) {
+      batch.push_back(pool.acquire());
+      Fill(batch[i].get());
+    }
+    batch.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["hit_rate"] = pool.stats().hit_rate();
+}
+
+BENCHMARK(BM_MakeUnique);
+BENCHMARK(BM_Pool);
+BENCHMARK(BM_MakeUniqueBatch)->Arg(256);
+BENCHMARK(BM_PoolBatch)->Arg(256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "../SharedPtr.h"
+
+// Copy and destroy throughput of std::shared_ptr against my::SharedPtr with
+// atomic and with plain reference counts. Copy makes and drops one copy per
+// iteration; Fanout copies one pointer into state.range(0) slots and
+// clears them; Make builds and drops a fresh object each iteration.
+//
+// libstdc++'s shared_ptr skips atomics until the program starts its first
+// thread, so main starts one first; the numbers are then those of any
+// multithreaded program, where std::shared_ptr pays for atomics everywhere.
+
+struct Payload {
+  std::int64_t a = 1;
+  std::int64_t b = 2;
+};
+
+struct Std {
+  using Ptr = std::shared_ptr<Payload>;
+  static Ptr Make() { return std::make_shared<Payload>(); }
+};
+
+struct MyAtomic {
+  using Ptr = my::SharedPtr<Payload, my::AtomicCount>;
+  static Ptr Make() { return my::make_shared<Payload, my::AtomicCount>(); }
+};
+
+struct MyLocal {
+  using Ptr = my::SharedPtr<Payload, my::LocalCount>;
+  static Ptr Make() { return my::make_shared<Payload, my::LocalCount>(); }
+};
+
+template <typename Kind>
+static void BM_Copy(benchmark::State &state) {
+  typename Kind::Ptr p = Kind::Make();
+  for (auto _ : state) {
+    typename Kind::Ptr copy = p;
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Kind>
+static void BM_Fanout(benchmark::State &state) {
+  typename Kind::Ptr p = Kind::Make();
+  std::vector<typename Kind::Ptr> slots(state.range(0));
+  for (auto _ : state) {
+    for (auto &slot : slots) {
+      slot = p;
+    }
+    benchmark::DoNotOptimize(slots.data());
+    for (auto &slot : slots) {
+      slot.reset();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Kind>
+static void BM_Make(benchmark::State &state) {
+  for (auto _ : state) {
+    typename Kind::Ptr p = Kind::Make();
+    benchmark::DoNotOptimize(p.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_Copy, Std);
+BENCHMARK_TEMPLATE(BM_Copy, MyAtomic);
+BENCHMARK_TEMPLATE(BM_Copy, MyLocal);
+BENCHMARK_TEMPLATE(BM_Fanout, Std)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_Fanout, MyAtomic)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_Fanout, MyLocal)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_Make, Std);
+BENCHMARK_TEMPLATE(BM_Make, MyAtomic);
+BENCHMARK_TEMPLATE(BM_Make, MyLocal);
+
+int main(int argc, char** argv) {
+  std::thread([]() {}).join();
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,143 @@
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "../UniquePtr.h"
+#include "../SlabPool.h"
+#include "../Arena.h"
+
+// Allocation and destruction of small objects through my::make_unique
+// (operator new and delete) and my::make_unique_pooled (the thread's slab
+// pool). Churn makes and drops one object per iteration; Batch holds
+// state.range(0) objects at once before dropping them all; CrossThread
+// makes a batch on one thread and drops it on another, so the frees go
+// through the remote free list.
+//
+// The Teardown benchmarks time only the destruction of a complete binary
+// tree state.range(0) levels deep (2^20 - 1 nodes): heap nodes owning
+// their children through UniquePtr, against arena nodes linked by raw
+// pointer whose root is dropped before one Arena::reset(). Rebuilding the
+// tree is untimed but slow, so these run a fixed number of iterations.
+
+struct Node {
+  std::int64_t key;
+  std::int64_t value;
+  Node* next;
+
+  Node(std::int64_t k, std::int64_t v)
+  : key(k), value(v), next(nullptr) {}
+};
+
+struct MakeUnique {
+  using Ptr = my::UniquePtr<Node>;
+  static Ptr Make(std::int64_t i) { return my::make_unique<Node>(i, i); }
+};
+
+struct MakeUniquePooled {
+  using Ptr = my::UniquePtr<Node, my::pool_delete<Node>>;
+  static Ptr Make(std::int64_t i) { return my::make_unique_pooled<Node>(i, i); }
+};
+
+template <typename Maker>
+static void BM_Churn(benchmark::State &state) {
+  std::int64_t i {0};
+  for (auto _ : state) {
+    auto p = Maker::Make(i++);
+    benchmark::DoNotOptimize(p.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Maker>
+static void BM_Batch(benchmark::State &state) {
+  std::vector<typename Maker::Ptr> held;
+  held.reserve(state.range(0));
+  for (auto _ : state) {
+    for (std::int64_t i {0}; i < state.range(0); i++) {
+      held.push_back(Maker::Make(i));
+    }
+    benchmark::DoNotOptimize(held.data());
+    held.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Maker>
+static void BM_CrossThread(benchmark::State &state) {
+  std::vector<typename Maker::Ptr> held;
+  held.reserve(state.range(0));
+  for (auto _ : state) {
+    for (std::int64_t i {0}; i < state.range(0); i++) {
+      held.push_back(Maker::Make(i));
+    }
+    std::thread freer([&held]() { held.clear(); });
+    freer.join();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+struct HeapTreeNode {
+  my::UniquePtr<HeapTreeNode> left;
+  my::UniquePtr<HeapTreeNode> right;
+  std::int64_t value = 0;
+};
+
+struct ArenaTreeNode {
+  ArenaTreeNode* left = nullptr;
+  ArenaTreeNode* right = nullptr;
+  std::int64_t value = 0;
+};
+
+static void BuildHeapTree(HeapTreeNode* node, int depth) {
+  if (depth > 1) {
+    node->left = my::make_unique<HeapTreeNode>();
+    node->right = my::make_unique<HeapTreeNode>();
+    BuildHeapTree(node->left.get(), depth - 1);
+    BuildHeapTree(node->right.get(), depth - 1);
+  }
+}
+
+static void BuildArenaTree(my::Arena &arena, ArenaTreeNode* node, int depth) {
+  if (depth > 1) {
+    node->left = arena.create<ArenaTreeNode>();
+    node->right = arena.create<ArenaTreeNode>();
+    BuildArenaTree(arena, node->left, depth - 1);
+    BuildArenaTree(arena, node->right, depth - 1);
+  }
+}
+
+static void BM_TeardownHeapTree(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto root = my::make_unique<HeapTreeNode>();
+    BuildHeapTree(root.get(), state.range(0));
+    state.ResumeTiming();
+    root.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * ((std::int64_t(1) << state.range(0)) - 1));
+}
+
+static void BM_TeardownArenaTree(benchmark::State &state) {
+  my::Arena arena;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto root = my::make_unique_in<ArenaTreeNode>(arena);
+    BuildArenaTree(arena, root.get(), state.range(0));
+    state.ResumeTiming();
+    arena.drop(std::move(root));
+    arena.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * ((std::int64_t(1) << state.range(0)) - 1));
+}
+
+BENCHMARK_TEMPLATE(BM_Churn, MakeUnique);
+BENCHMARK_TEMPLATE(BM_Churn, MakeUniquePooled);
+BENCHMARK_TEMPLATE(BM_Batch, MakeUnique)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Batch, MakeUniquePooled)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_CrossThread, MakeUnique)->Arg(1 << 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CrossThread, MakeUniquePooled)->Arg(1 << 16)->UseRealTime();
+
+BENCHMARK(BM_TeardownHeapTree)->Arg(20)->Iterations(10)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TeardownArenaTree)->Arg(20)->Iterations(10)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,125 @@
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+#include "../ArrayAlloc.h"
+
+using my::SizedUniquePtr;
+using my::UniquePtr;
+
+struct Counted {
+  static int alive;
+
+  int value = 5;
+
+  Counted() { alive++; }
+  ~Counted() { alive--; }
+};
+
+int Counted::alive = 0;
+
+// Throws while building the third element
+struct ThirdThrows {
+  static int made;
+
+  ThirdThrows() {
+    if (++made == 3) {
+      throw std::runtime_error("third");
+    }
+  }
+};
+
+int ThirdThrows::made = 0;
+
+static_assert(sizeof(UniquePtr<float[], my::aligned_delete<float[]>>) == sizeof(float*));
+static_assert(sizeof(UniquePtr<float[], my::page_delete<float[]>>) == sizeof(float*));
+static_assert(sizeof(SizedUniquePtr<float[]>) == 2 * sizeof(float*));
+
+static bool AlignedTo(const void* p, std::size_t align) {
+  return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+}
+
+TEST(ArrayAllocTest, ForOverwriteUsesDefaultDelete) {
+  UniquePtr<int[]> buf = my::make_unique_for_overwrite<int[]>(1000);
+  for (int i {0}; i < 1000; i++) {
+    buf[i] = i;
+  }
+  EXPECT_EQ(buf[999], 999);
+  auto strings = my::make_unique_for_overwrite<std::string[]>(3); // Class types are still constructed
+  EXPECT_TRUE(strings[2].empty());
+}
+
+TEST(ArrayAllocTest, AlignedArrays) {
+  for (std::size_t align : {16, 64, 256, 4096}) {
+    auto buf = my::make_unique_aligned<float[]>(1001, align);
+    EXPECT_TRUE(AlignedTo(buf.get(), align));
+    EXPECT_EQ(buf[0], 0.0f); // Value-initialized
+    EXPECT_EQ(buf[1000], 0.0f);
+  }
+  EXPECT_THROW(my::make_unique_aligned<float[]>(8, 48), std::invalid_argument);
+
+  Counted::alive = 0;
+  {
+    auto objects = my::make_unique_aligned<Counted[]>(10, 64);
+    EXPECT_EQ(Counted::alive, 10);
+    EXPECT_EQ(objects[9].value, 5);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(ArrayAllocTest, PageArrays) {
+  auto small = my::make_unique_pages<char[]>(100);
+  EXPECT_TRUE(AlignedTo(small.get(), 64));
+  small[99] = 'x';
+
+  std::size_t n = (std::size_t(8) << 20) / sizeof(std::uint64_t);
+  auto large = my::make_unique_pages<std::uint64_t[]>(n);
+  EXPECT_TRUE(AlignedTo(large.get(), 64));
+  EXPECT_EQ(large[n - 1], 0); // Zeroed by the kernel
+  std::iota(large.get(), large.get() + n, std::uint64_t(0));
+  EXPECT_EQ(large[n - 1], n - 1);
+
+  Counted::alive = 0;
+  {
+    auto objects = my::make_unique_pages<Counted[]>(3);
+    EXPECT_EQ(Counted::alive, 3);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(ArrayAllocTest, ThrowingConstructorFreesEverything) {
+  ThirdThrows::made = 0;
+  EXPECT_THROW(my::make_unique_aligned<ThirdThrows[]>(5, 64), std::runtime_error);
+  ThirdThrows::made = 0;
+  EXPECT_THROW(my::make_unique_pages<ThirdThrows[]>(5), std::runtime_error);
+}
+
+TEST(ArrayAllocTest, SizedUniquePtrIteratesAndChecks) {
+  SizedUniquePtr<int[], my::aligned_delete<int[]>> buf (my::make_unique_aligned<int[]>(100, 64), 100);
+  EXPECT_EQ(buf.size(), 100);
+  std::iota(buf.begin(), buf.end(), 0);
+  int sum {0};
+  for (int x : buf) {
+    sum += x;
+  }
+  EXPECT_EQ(sum, 4950);
+  EXPECT_EQ(buf.at(99), 99);
+  EXPECT_THROW(buf.at(100), std::out_of_range);
+
+  auto moved = std::move(buf);
+  EXPECT_EQ(buf.size(), 0);
+  EXPECT_EQ(buf.begin(), buf.end());
+  EXPECT_EQ(moved[42], 42);
+
+  UniquePtr<int[], my::aligned_delete<int[]>> plain = moved.release();
+  EXPECT_TRUE(moved.empty());
+  EXPECT_EQ(plain[1], 1);
+}
+
+#ifndef NDEBUG
+TEST(ArrayAllocDeathTest, IndexPastSizeAborts) {
+  SizedUniquePtr<int[]> buf (my::make_unique_for_overwrite<int[]>(4), 4);
+  EXPECT_DEATH(buf[4] = 1, "out of range");
+}
+#endif
@@ -0,0 +1,164 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../AtomicUniquePtr.h"
+
+using my::AtomicUniquePtr;
+using my::UniquePtr;
+
+// A routing table whose fields must always agree with each other
+struct Table {
+  static std::atomic<int> alive;
+
+  std::uint64_t version;
+  std::uint64_t check;
+
+  explicit Table(std::uint64_t v)
+  : version(v), check(v * 31) { alive++; }
+
+  ~Table() {
+    check = 0; // A reader seeing a freed table would notice
+    alive--;
+  }
+};
+
+std::atomic<int> Table::alive {0};
+
+static_assert(sizeof(AtomicUniquePtr<Table>::RetiredType) == sizeof(Table*));
+static_assert(sizeof(AtomicUniquePtr<Table>) == sizeof(Table*));
+
+class AtomicUniquePtrTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Table::alive = 0; }
+
+  void TearDown() override {
+    my::detail::EpochDomain::Instance().Collect();
+    EXPECT_EQ(Table::alive, 0);
+  }
+};
+
+TEST_F(AtomicUniquePtrTest, LoadSeesStoredObject) {
+  AtomicUniquePtr<Table> table;
+  EXPECT_FALSE(table.load());
+  EXPECT_TRUE(table.is_lock_free());
+  table.store(my::make_unique<Table>(1));
+  EXPECT_EQ(table.load()->version, 1);
+  table.store(my::make_unique<Table>(2));
+  EXPECT_EQ(table.load()->version, 2);
+  my::detail::EpochDomain::Instance().Collect();
+  EXPECT_EQ(Table::alive, 1); // Version 1 retired and freed
+}
+
+TEST_F(AtomicUniquePtrTest, GuardKeepsReplacedObjectAlive) {
+  AtomicUniquePtr<Table> table (my::make_unique<Table>(1));
+  {
+    auto guard = table.load();
+    table.store(my::make_unique<Table>(2));
+    my::detail::EpochDomain::Instance().Collect();
+    EXPECT_EQ(Table::alive, 2);
+    EXPECT_EQ(guard->version, 1);
+    EXPECT_EQ(guard->check, 31);
+  }
+  my::detail::EpochDomain::Instance().Collect();
+  EXPECT_EQ(Table::alive, 1);
+}
+
+TEST_F(AtomicUniquePtrTest, ExchangeHandsBackRetiringPointer) {
+  AtomicUniquePtr<Table> table (my::make_unique<Table>(1));
+  {
+    auto old = table.exchange(my::make_unique<Table>(2));
+    EXPECT_EQ(old->version, 1);
+    EXPECT_EQ(table.load()->version, 2);
+  }
+  // Dropping it retired rather than deleted; collected once nobody is pinned
+  EXPECT_EQ(my::detail::EpochDomain::Instance().Collect(), 0);
+  EXPECT_EQ(Table::alive, 1);
+}
+
+TEST_F(AtomicUniquePtrTest, CompareExchange) {
+  AtomicUniquePtr<Table> table (my::make_unique<Table>(1));
+  Table* expected = table.load().get();
+  UniquePtr<Table> next = my::make_unique<Table>(2);
+  EXPECT_TRUE(table.compare_exchange(expected, next));
+  EXPECT_EQ(next.get(), nullptr);
+
+  UniquePtr<Table> stale = my::make_unique<Table>(3);
+  EXPECT_FALSE(table.compare_exchange(expected, stale)); // expected is version 1
+  EXPECT_EQ(expected, table.load().get());
+  EXPECT_EQ(stale->version, 3); // Still ours
+  EXPECT_TRUE(table.compare_exchange(expected, stale));
+  EXPECT_EQ(table.load()->version, 3);
+}
+
+TEST_F(AtomicUniquePtrTest, StatefulDeleterRunsOnRetire) {
+  int deleted {0};
+  auto counted = [&deleted](Table* p) { deleted++; delete p; };
+  {
+    AtomicUniquePtr<Table, decltype(counted)> table (UniquePtr<Table, decltype(counted)>(new Table(1), counted));
+    table.store(UniquePtr<Table, decltype(counted)>(new Table(2), counted));
+    my::detail::EpochDomain::Instance().Collect();
+    EXPECT_EQ(deleted, 1);
+  }
+  EXPECT_EQ(deleted, 2);
+}
+
+TEST_F(AtomicUniquePtrTest, ReadersNeverSeeFreedTables) {
+  AtomicUniquePtr<Table> table (my::make_unique<Table>(0));
+  std::atomic<bool> done {false};
+  std::atomic<int> bad {0};
+  std::vector<std::thread> readers;
+  for (int r {0}; r < 4; r++) {
+    readers.emplace_back([&]() {
+      std::uint64_t last {0};
+      while (!done.load()) {
+        auto guard = table.load();
+        if (guard->check != guard->version * 31 || guard->version < last) {
+          bad++;
+        }
+        last = guard->version;
+      }
+    });
+  }
+  for (std::uint64_t v {1}; v <= 20000; v++) {
+    table.store(my::make_unique<Table>(v));
+  }
+  done = true;
+  for (auto &t : readers) {
+    t.join();
+  }
+  EXPECT_EQ(bad.load(), 0);
+  EXPECT_EQ(table.load()->version, 20000);
+}
+
+TEST_F(AtomicUniquePtrTest, ConcurrentWritersAndReaders) {
+  AtomicUniquePtr<Table> table (my::make_unique<Table>(0));
+  std::atomic<int> writing {3};
+  std::atomic<int> bad {0};
+  std::vector<std::thread> threads;
+  for (int r {0}; r < 3; r++) {
+    threads.emplace_back([&]() {
+      while (writing.load() > 0) {
+        auto guard = table.load();
+        if (guard->check != guard->version * 31) { // Freed under the guard
+          bad++;
+        }
+      }
+    });
+  }
+  for (std::uint64_t w {0}; w < 3; w++) {
+    threads.emplace_back([&, w]() {
+      for (std::uint64_t v {1}; v <= 10000; v++) {
+        table.store(my::make_unique<Table>(v * 3 + w));
+      }
+      writing--;
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(bad.load(), 0);
+  my::detail::EpochDomain::Instance().Collect();
+  EXPECT_EQ(Table::alive, 1);
+}
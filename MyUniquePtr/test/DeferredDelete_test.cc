@@ -0,0 +1,149 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../DeferredDelete.h"
+
+using my::UniquePtr;
+
+template <typename T>
+using DeferredPtr = UniquePtr<T, my::deferred_delete<T>>;
+
+// An order book node whose destructor notes the thread it ran on
+struct Order {
+  static std::atomic<int> alive;
+  static std::atomic<int> off_thread;
+  static std::thread::id caller;
+
+  DeferredPtr<Order> next;
+
+  Order() { alive++; }
+
+  ~Order() {
+    if (std::this_thread::get_id() != caller) {
+      off_thread++;
+    }
+    alive--;
+  }
+};
+
+std::atomic<int> Order::alive {0};
+std::atomic<int> Order::off_thread {0};
+std::thread::id Order::caller;
+
+// Holds up the sweep that destroys it until let go
+struct Blocker {
+  static std::atomic<bool> entered;
+  static std::atomic<bool> release;
+
+  ~Blocker() {
+    entered = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+std::atomic<bool> Blocker::entered {false};
+std::atomic<bool> Blocker::release {false};
+
+static_assert(sizeof(DeferredPtr<Order>) == sizeof(Order*));
+
+class DeferredDeleteTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    my::flush_deferred_deletes();
+    Order::alive = 0;
+    Order::off_thread = 0;
+    Order::caller = std::this_thread::get_id();
+  }
+
+  void TearDown() override {
+    my::flush_deferred_deletes();
+    EXPECT_EQ(Order::alive, 0);
+  }
+};
+
+TEST_F(DeferredDeleteTest, DestroysOnTheBackgroundThread) {
+  for (int i {0}; i < 100; i++) {
+    DeferredPtr<Order> order (new Order());
+  }
+  for (int wait {0}; wait < 2000 && Order::alive != 0; wait++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(Order::alive, 0);
+  EXPECT_EQ(Order::off_thread, 100);
+}
+
+TEST_F(DeferredDeleteTest, FlushDestroysEverythingRetired) {
+  my::ReclaimStats before = my::deferred_delete_stats();
+  for (int i {0}; i < 1000; i++) {
+    DeferredPtr<Order> order (new Order());
+  }
+  my::flush_deferred_deletes();
+  EXPECT_EQ(Order::alive, 0);
+  my::ReclaimStats after = my::deferred_delete_stats();
+  EXPECT_EQ(after.pending, 0);
+  EXPECT_EQ(after.retired - before.retired + after.inline_deletes - before.inline_deletes, 1000);
+  EXPECT_EQ(after.reclaimed, after.retired);
+}
+
+TEST_F(DeferredDeleteTest, DeepGraphComesApartWithoutRecursion) {
+  DeferredPtr<Order> head (new Order());
+  Order* tail = head.get();
+  for (int i {0}; i < 100000; i++) { // Inline destruction this deep recurses 100000 frames
+    tail->next = DeferredPtr<Order>(new Order());
+    tail = tail->next.get();
+  }
+  head.reset();
+  my::flush_deferred_deletes();
+  EXPECT_EQ(Order::alive, 0);
+}
+
+TEST_F(DeferredDeleteTest, FullRingFallsBackToInline) {
+  Blocker::entered = false;
+  Blocker::release = false;
+  DeferredPtr<Blocker> blocker (new Blocker());
+  blocker.reset();
+  while (!Blocker::entered) { // The background sweep is now stuck in ~Blocker
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  my::ReclaimStats before = my::deferred_delete_stats();
+  int room = static_cast<int>(my::detail::Reclaimer::kRingSize - before.pending); // Blocker's slot is still taken
+  for (int i {0}; i < room + 100; i++) {
+    DeferredPtr<Order> order (new Order());
+  }
+  my::ReclaimStats after = my::deferred_delete_stats();
+  EXPECT_EQ(after.inline_deletes - before.inline_deletes, 100);
+  EXPECT_EQ(Order::alive, room); // Queued; the 100 that did not fit are gone
+  EXPECT_EQ(after.pending, my::detail::Reclaimer::kRingSize);
+  Blocker::release = true;
+}
+
+TEST_F(DeferredDeleteTest, ExitedThreadsRingsAreDrained) {
+  std::vector<std::thread> threads;
+  for (int t {0}; t < 4; t++) {
+    threads.emplace_back([]() {
+      for (int i {0}; i < 1000; i++) {
+        DeferredPtr<Order> order (new Order());
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  my::flush_deferred_deletes();
+  EXPECT_EQ(Order::alive, 0);
+  my::ReclaimStats stats = my::deferred_delete_stats();
+  EXPECT_GT(stats.max_pending, 0);
+  EXPECT_GT(stats.max_latency_ns, 0);
+}
+
+TEST_F(DeferredDeleteTest, Arrays) {
+  {
+    UniquePtr<Order[], my::deferred_delete<Order[]>> orders (new Order[8]);
+  }
+  my::flush_deferred_deletes();
+  EXPECT_EQ(Order::alive, 0);
+}
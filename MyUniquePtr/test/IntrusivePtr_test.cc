@@ -0,0 +1,161 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../IntrusivePtr.h"
+
+using my::IntrusivePtr;
+
+struct Message : my::RefCounted<> {
+  static int alive;
+
+  std::string text;
+
+  explicit Message(std::string t)
+  : text(std::move(t)) { alive++; }
+
+  virtual ~Message() { alive--; }
+};
+
+int Message::alive = 0;
+
+struct Urgent : Message {
+  using Message::Message;
+  int priority = 1;
+};
+
+struct LocalMessage : my::RefCounted<my::LocalCount> {
+  int id = 0;
+};
+
+// A type with hooks of its own: release() destroys the object itself
+struct SelfDeleting {
+  static int destroyed;
+
+  int refs = 0;
+
+  void add_ref() { refs++; }
+
+  void release() {
+    if (--refs == 0) {
+      destroyed++;
+      delete this;
+    }
+  }
+};
+
+int SelfDeleting::destroyed = 0;
+
+static_assert(sizeof(IntrusivePtr<Message>) == sizeof(Message*));
+static_assert(sizeof(IntrusivePtr<SelfDeleting>) == sizeof(SelfDeleting*));
+
+class IntrusivePtrTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Message::alive = 0; }
+  void TearDown() override { EXPECT_EQ(Message::alive, 0); }
+};
+
+TEST_F(IntrusivePtrTest, CopiesCountInTheObject) {
+  auto a = my::make_intrusive<Message>("hello");
+  EXPECT_EQ(a->use_count(), 1);
+  {
+    IntrusivePtr<Message> b = a;
+    IntrusivePtr<Message> c;
+    c = b;
+    EXPECT_EQ(a->use_count(), 3);
+    EXPECT_EQ(c->text, "hello");
+    EXPECT_EQ(a, c);
+  }
+  EXPECT_EQ(a->use_count(), 1);
+  IntrusivePtr<Message> moved = std::move(a);
+  EXPECT_FALSE(a);
+  EXPECT_EQ(moved->use_count(), 1);
+  moved = nullptr;
+}
+
+TEST_F(IntrusivePtrTest, RawPointersShareTheCount) {
+  Message* raw = new Message("shared");
+  IntrusivePtr<Message> a (raw);
+  IntrusivePtr<Message> b (raw); // Unlike UniquePtr, a second owner from the raw pointer is fine
+  EXPECT_EQ(raw->use_count(), 2);
+
+  Message* detached = a.detach();
+  EXPECT_EQ(detached->use_count(), 2); // a's reference now held by hand
+  IntrusivePtr<Message> adopted (detached, false);
+  EXPECT_EQ(raw->use_count(), 2);
+}
+
+TEST_F(IntrusivePtrTest, ConvertsToBase) {
+  IntrusivePtr<Urgent> urgent = my::make_intrusive<Urgent>("now");
+  IntrusivePtr<Message> base = urgent;
+  EXPECT_EQ(base->use_count(), 2);
+  urgent.reset();
+  EXPECT_EQ(base->text, "now");
+}
+
+TEST_F(IntrusivePtrTest, AdoptsAndReleasesUniquePtr) {
+  my::UniquePtr<Message> unique (new Message("unique"));
+  IntrusivePtr<Message> shared = std::move(unique);
+  EXPECT_EQ(unique.get(), nullptr);
+  EXPECT_EQ(shared->use_count(), 1);
+
+  IntrusivePtr<Message> other = shared;
+  EXPECT_THROW(shared.release_unique(), std::logic_error);
+  EXPECT_EQ(shared->use_count(), 2);
+  other.reset();
+
+  my::UniquePtr<Message> back = shared.release_unique();
+  EXPECT_FALSE(shared);
+  EXPECT_EQ(back->use_count(), 0);
+  EXPECT_EQ(back->text, "unique");
+  IntrusivePtr<Message> again = std::move(back); // Round trip
+  EXPECT_EQ(again->use_count(), 1);
+}
+
+TEST_F(IntrusivePtrTest, ReleaseAllDropsEveryReference) {
+  MyVector<IntrusivePtr<Message>> batch;
+  auto kept = my::make_intrusive<Message>("kept");
+  for (int i {0}; i < 1000; i++) {
+    batch.push_back(my::make_intrusive<Message>(std::to_string(i)));
+    batch.push_back(kept);
+  }
+  EXPECT_EQ(Message::alive, 1001);
+  EXPECT_EQ(kept->use_count(), 1001);
+  my::release_all(batch);
+  EXPECT_EQ(batch.size(), 0);
+  EXPECT_EQ(Message::alive, 1);
+  EXPECT_EQ(kept->use_count(), 1);
+}
+
+TEST_F(IntrusivePtrTest, CustomHooksAndLocalCounts) {
+  SelfDeleting::destroyed = 0;
+  {
+    IntrusivePtr<SelfDeleting> a (new SelfDeleting());
+    IntrusivePtr<SelfDeleting> b = a;
+    EXPECT_EQ(a->refs, 2);
+  }
+  EXPECT_EQ(SelfDeleting::destroyed, 1);
+
+  auto local = my::make_intrusive<LocalMessage>();
+  IntrusivePtr<LocalMessage> copy = local;
+  EXPECT_EQ(local->use_count(), 2);
+}
+
+TEST_F(IntrusivePtrTest, AtomicCountsAcrossThreads) {
+  auto shared = my::make_intrusive<Message>("threads");
+  std::vector<std::thread> threads;
+  for (int t {0}; t < 4; t++) {
+    threads.emplace_back([shared]() {
+      for (int i {0}; i < 10000; i++) {
+        IntrusivePtr<Message> copy = shared;
+        EXPECT_EQ(copy->text, "threads");
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(shared->use_count(), 1);
+}
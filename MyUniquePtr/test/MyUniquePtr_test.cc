@@ -2,7 +2,14 @@
 #include <memory>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 #include "../UniquePtr.h"
+#include "../SlabPool.h"
+#include "../Arena.h"
 
 using std::unique_ptr;
 using my::UniquePtr; 
@@ -291,6 +298,287 @@ TEST(UniquePtrTest, MakeUniqueArrayTest) {
   }
 }
 
+// Stateless deleters are folded into the pointer
+struct CountingDelete {
+  static int calls;
+
+  void operator()(int* p) const {
+    calls++;
+    delete p;
+  }
+};
+
+int CountingDelete::calls = 0;
+
+struct StatefulDelete {
+  int* calls;
+
+  void operator()(int* p) const {
+    (*calls)++;
+    delete p;
+  }
+};
+
+void FreeInt(int* p) {
+  delete p;
+}
+
+auto lambda_delete = [](int* p) { delete p; };
+auto lambda_array_delete = [](int* p) { delete[] p; };
+
+static_assert(sizeof(UniquePtr<int>) == sizeof(int*));
+static_assert(sizeof(UniquePtr<Point>) == sizeof(Point*));
+static_assert(sizeof(UniquePtr<int[]>) == sizeof(int*));
+static_assert(sizeof(UniquePtr<int, CountingDelete>) == sizeof(int*));
+static_assert(sizeof(UniquePtr<int, decltype(lambda_delete)>) == sizeof(int*));
+static_assert(sizeof(UniquePtr<int[], decltype(lambda_array_delete)>) == sizeof(int*));
+static_assert(sizeof(UniquePtr<int, StatefulDelete>) == sizeof(int*) + sizeof(int*));
+static_assert(sizeof(UniquePtr<int, void (*)(int*)>) == 2 * sizeof(int*));
+
+TEST(UniquePtrDeleter, StatelessDeleterRunsOnce) {
+  CountingDelete::calls = 0;
+  {
+    UniquePtr<int, CountingDelete> a (new int(1));
+    UniquePtr<int, CountingDelete> b (std::move(a));
+    UniquePtr<int, CountingDelete> c (new int(2));
+    c = std::move(b); // Deletes c's old pointee
+    EXPECT_EQ(CountingDelete::calls, 1);
+    EXPECT_EQ(*c, 1);
+  }
+  EXPECT_EQ(CountingDelete::calls, 2);
+}
+
+TEST(UniquePtrDeleter, LambdaDeleter) {
+  int calls {0};
+  {
+    auto counted = [&calls](int* p) { calls++; delete p; };
+    UniquePtr<int, decltype(counted)> a (new int(3), counted);
+    UniquePtr<int, decltype(counted)> b (std::move(a));
+    EXPECT_THAT(a.get(), IsNull());
+    EXPECT_EQ(*b, 3);
+  }
+  EXPECT_EQ(calls, 1);
+
+  UniquePtr<int[], decltype(lambda_array_delete)> array (new int[4] {1, 2, 3, 4}, lambda_array_delete);
+  EXPECT_EQ(array[3], 4);
+}
+
+TEST(UniquePtrDeleter, StatefulAndFunctionPointerDeleters) {
+  int calls {0};
+  {
+    UniquePtr<int, StatefulDelete> a (new int(4), StatefulDelete {&calls});
+    UniquePtr<int, StatefulDelete> b (std::move(a));
+    EXPECT_EQ(b.get_deleter().calls, &calls);
+  }
+  EXPECT_EQ(calls, 1);
+
+  UniquePtr<int, void (*)(int*)> f (new int(5), &FreeInt);
+  EXPECT_EQ(f.get_deleter(), &FreeInt);
+}
+
+// make_unique_pooled
+struct PoolNode {
+  static int alive;
+
+  long a, b;
+  PoolNode* next = nullptr;
+
+  PoolNode(long a, long b)
+  : a(a), b(b) { alive++; }
+
+  ~PoolNode() { alive--; }
+};
+
+int PoolNode::alive = 0;
+
+// Own types, so each test below starts from an empty pool
+struct RemoteNode : PoolNode {
+  using PoolNode::PoolNode;
+};
+
+struct AdoptedNode : PoolNode {
+  using PoolNode::PoolNode;
+};
+
+struct ThrowingNode {
+  explicit ThrowingNode(bool fail) {
+    if (fail) {
+      throw std::runtime_error("construction failed");
+    }
+  }
+};
+
+static_assert(sizeof(UniquePtr<PoolNode, my::pool_delete<PoolNode>>) == sizeof(PoolNode*));
+
+TEST(UniquePtrPooled, ConstructsAndDestroys) {
+  {
+    auto p = my::make_unique_pooled<PoolNode>(1, 2);
+    EXPECT_EQ(p->a, 1);
+    EXPECT_EQ(p->b, 2);
+    EXPECT_EQ(PoolNode::alive, 1);
+  }
+  EXPECT_EQ(PoolNode::alive, 0);
+}
+
+TEST(UniquePtrPooled, ReusesFreedSlots) {
+  PoolNode* first = my::make_unique_pooled<PoolNode>(1, 1).get(); // Freed at once
+  auto second = my::make_unique_pooled<PoolNode>(2, 2);
+  EXPECT_EQ(second.get(), first);
+
+  std::set<PoolNode*> seen;
+  std::vector<UniquePtr<PoolNode, my::pool_delete<PoolNode>>> many;
+  for (long i {0}; i < 10000; i++) {
+    many.push_back(my::make_unique_pooled<PoolNode>(i, i));
+    seen.insert(many.back().get());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(many.back().get()) % alignof(PoolNode), 0);
+  }
+  EXPECT_EQ(seen.size(), 10000); // Live objects never share a slot
+  std::size_t slabs = my::detail::SlabPool<PoolNode>::Current().slabs();
+  many.clear();
+  for (long i {0}; i < 10000; i++) {
+    many.push_back(my::make_unique_pooled<PoolNode>(i, i));
+  }
+  EXPECT_EQ(my::detail::SlabPool<PoolNode>::Current().slabs(), slabs); // All from freed slots
+}
+
+TEST(UniquePtrPooled, CrossThreadFreesReturnToOwner) {
+  std::vector<UniquePtr<RemoteNode, my::pool_delete<RemoteNode>>> made;
+  std::set<RemoteNode*> addresses;
+  for (long i {0}; i < 1000; i++) {
+    made.push_back(my::make_unique_pooled<RemoteNode>(i, -i));
+    addresses.insert(made.back().get());
+  }
+  std::thread freer([&made]() { made.clear(); });
+  freer.join();
+  EXPECT_EQ(PoolNode::alive, 0);
+
+  for (long i {0}; i < 1000; i++) { // Served from the remote free list
+    made.push_back(my::make_unique_pooled<RemoteNode>(i, i));
+    EXPECT_EQ(addresses.count(made.back().get()), 1);
+  }
+}
+
+TEST(UniquePtrPooled, ExitedThreadsPoolIsAdopted) {
+  AdoptedNode* from_exited {nullptr};
+  UniquePtr<AdoptedNode, my::pool_delete<AdoptedNode>> survivor;
+  std::thread maker([&]() {
+    survivor = my::make_unique_pooled<AdoptedNode>(7, 7);
+    from_exited = survivor.get();
+  });
+  maker.join();
+  EXPECT_EQ(survivor->a, 7); // Outlives its thread
+  survivor.reset();
+
+  AdoptedNode* adopted {nullptr};
+  std::thread adopter([&]() { adopted = my::make_unique_pooled<AdoptedNode>(8, 8).get(); });
+  adopter.join();
+  EXPECT_EQ(adopted, from_exited);
+}
+
+TEST(UniquePtrPooled, ThrowingConstructorGivesSlotBack) {
+  void* slot = my::make_unique_pooled<ThrowingNode>(false).get();
+  EXPECT_THROW(my::make_unique_pooled<ThrowingNode>(true), std::runtime_error);
+  EXPECT_EQ(static_cast<void*>(my::make_unique_pooled<ThrowingNode>(false).get()), slot);
+}
+
+// make_unique_in
+struct ArenaNode {
+  ArenaNode* left = nullptr;
+  ArenaNode* right = nullptr;
+  int value = 0;
+};
+
+struct alignas(64) WideNode {
+  char bytes[64];
+};
+
+static_assert(std::is_trivially_destructible<ArenaNode>::value);
+static_assert(sizeof(UniquePtr<ArenaNode, my::arena_delete<ArenaNode>>) == sizeof(ArenaNode*));
+static_assert(sizeof(UniquePtr<std::string, my::arena_delete<std::string>>) == sizeof(std::string*));
+
+TEST(UniquePtrArena, RunsDestructorsOnce) {
+  my::Arena arena;
+  PoolNode::alive = 0;
+  {
+    auto a = my::make_unique_in<PoolNode>(arena, 1, 2);
+    auto b = my::make_unique_in<PoolNode>(arena, 3, 4);
+    EXPECT_EQ(PoolNode::alive, 2);
+    EXPECT_EQ(b->a, 3);
+    auto c = std::move(a);
+    EXPECT_THAT(a.get(), IsNull());
+  }
+  EXPECT_EQ(PoolNode::alive, 0);
+  auto text = my::make_unique_in<std::string>(arena, 100, 'x'); // Owns heap memory of its own
+  EXPECT_EQ(text->size(), 100);
+}
+
+TEST(UniquePtrArena, AlignsObjects) {
+  my::Arena arena(256);
+  for (int i {0}; i < 100; i++) {
+    auto c = my::make_unique_in<char>(arena, 'c');
+    auto w = my::make_unique_in<WideNode>(arena);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(w.get()) % 64, 0);
+  }
+  void* big = arena.allocate(1 << 22, 4096); // Bigger than any chunk
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big) % 4096, 0);
+}
+
+TEST(UniquePtrArena, ResetKeepsOneChunk) {
+  my::Arena arena;
+  for (int round {0}; round < 3; round++) {
+    for (int i {0}; i < 100000; i++) {
+      auto node = my::make_unique_in<ArenaNode>(arena);
+      node->value = i;
+    }
+    EXPECT_GE(arena.used_bytes(), 100000 * sizeof(ArenaNode));
+    std::size_t reserved = arena.reserved_bytes();
+    arena.reset();
+    EXPECT_EQ(arena.used_bytes(), 0);
+    EXPECT_LT(arena.reserved_bytes(), reserved);
+    EXPECT_GT(arena.reserved_bytes(), 0);
+  }
+}
+
+TEST(UniquePtrArena, DropThenResetTearsDownTree) {
+  my::Arena arena;
+  auto root = my::make_unique_in<ArenaNode>(arena);
+  std::vector<ArenaNode*> level {root.get()};
+  for (int depth {0}; depth < 10; depth++) {
+    std::vector<ArenaNode*> next;
+    for (ArenaNode* n : level) {
+      n->left = arena.create<ArenaNode>();
+      n->right = arena.create<ArenaNode>();
+      next.push_back(n->left);
+      next.push_back(n->right);
+    }
+    level = next;
+  }
+  EXPECT_EQ(level.size(), 1024);
+  arena.drop(std::move(root));
+  EXPECT_THAT(root.get(), IsNull());
+  arena.reset();
+}
+
+TEST(UniquePtrArena, DropCountsOutOfTheOwningArena) {
+  my::Arena a;
+  my::Arena b;
+  auto node = my::make_unique_in<ArenaNode>(b);
+  a.drop(std::move(node));
+  EXPECT_THAT(node.get(), IsNull());
+  a.reset(); // Neither arena may think an object is still owned
+  b.reset();
+}
+
+TEST(UniquePtrArenaDeathTest, ResetWithLiveUniquePtr) {
+#ifndef NDEBUG
+  EXPECT_DEATH({
+    my::Arena arena;
+    auto node = my::make_unique_in<ArenaNode>(arena);
+    arena.reset();
+  }, "still own objects");
+#endif
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest();
   testing::InitGoogleMock();
@@ -0,0 +1,157 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../ObjectPool.h"
+
+using my::ObjectPool;
+
+// A message buffer that is costly to build: its storage is allocated up front
+struct Buffer {
+  static std::atomic<int> constructed;
+  static std::atomic<int> destroyed;
+
+  MyVector<int> data;
+  int resets = 0;
+
+  Buffer() {
+    constructed++;
+    data.reserve(1024);
+  }
+
+  ~Buffer() { destroyed++; }
+
+  void reset() {
+    data.clear();
+    resets++;
+  }
+};
+
+std::atomic<int> Buffer::constructed {0};
+std::atomic<int> Buffer::destroyed {0};
+
+struct Plain {
+  int value = 0;
+};
+
+static_assert(sizeof(ObjectPool<Buffer>::Handle) == sizeof(Buffer*));
+
+class ObjectPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Buffer::constructed = 0;
+    Buffer::destroyed = 0;
+  }
+};
+
+TEST_F(ObjectPoolTest, ReusesObjectsWithTheirCapacity) {
+  ObjectPool<Buffer> pool;
+  Buffer* first = nullptr;
+  {
+    auto buf = pool.acquire();
+    first = buf.get();
+    for (int i {0}; i < 100; i++) {
+      buf->data.push_back(i);
+    }
+  }
+  auto again = pool.acquire();
+  EXPECT_EQ(again.get(), first);
+  EXPECT_EQ(again->data.size(), 0); // reset() ran
+  EXPECT_EQ(again->data.capacity(), 1024); // Capacity kept
+  EXPECT_EQ(again->resets, 1);
+  EXPECT_EQ(Buffer::constructed, 1);
+  EXPECT_EQ(Buffer::destroyed, 0);
+}
+
+TEST_F(ObjectPoolTest, SteadyStateConstructsNothing) {
+  {
+    ObjectPool<Buffer> pool;
+    for (int round {0}; round < 1000; round++) {
+      std::vector<ObjectPool<Buffer>::Handle> batch;
+      for (int i {0}; i < 100; i++) {
+        batch.push_back(pool.acquire());
+      }
+    }
+    EXPECT_EQ(Buffer::constructed, 100);
+    my::PoolStats stats = pool.stats();
+    EXPECT_EQ(stats.misses, 100);
+    EXPECT_EQ(stats.hits, 99900);
+    EXPECT_EQ(stats.returns, 100000);
+    EXPECT_EQ(stats.idle, 100);
+    EXPECT_DOUBLE_EQ(stats.hit_rate(), 0.999);
+  }
+  EXPECT_EQ(Buffer::destroyed, 100); // The pool destroys what it holds
+}
+
+TEST_F(ObjectPoolTest, BoundedIdleObjects) {
+  ObjectPool<Buffer> pool (10);
+  {
+    std::vector<ObjectPool<Buffer>::Handle> batch;
+    for (int i {0}; i < 200; i++) {
+      batch.push_back(pool.acquire());
+    }
+  }
+  my::PoolStats stats = pool.stats();
+  EXPECT_LE(stats.idle, 10 + ObjectPool<Buffer>::kThreadCache);
+  EXPECT_EQ(stats.idle + stats.discarded, 200);
+  EXPECT_EQ(Buffer::destroyed.load(), stats.discarded);
+}
+
+TEST_F(ObjectPoolTest, ReserveAndCustomReset) {
+  ObjectPool<Plain> pool (64, [](Plain &p) { p.value = -1; });
+  pool.reserve(8);
+  EXPECT_EQ(pool.stats().idle, 8);
+  {
+    auto p = pool.acquire();
+    p->value = 5;
+  }
+  EXPECT_EQ(pool.acquire()->value, -1);
+  EXPECT_EQ(pool.stats().misses, 0);
+}
+
+TEST_F(ObjectPoolTest, ThreadsShareThePool) {
+  ObjectPool<Buffer> pool;
+  std::vector<std::thread> threads;
+  for (int t {0}; t < 4; t++) {
+    threads.emplace_back([&pool]() {
+      for (int i {0}; i < 10000; i++) {
+        auto a = pool.acquire();
+        auto b = pool.acquire();
+        a->data.push_back(i);
+        b->data.push_back(i);
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  my::PoolStats stats = pool.stats();
+  EXPECT_EQ(stats.hits + stats.misses, 80000);
+  EXPECT_EQ(stats.returns, 80000);
+  EXPECT_LE(stats.misses, 8 + 4 * ObjectPool<Buffer>::kThreadCache);
+  EXPECT_EQ(stats.idle, Buffer::constructed.load()); // Exited threads gave their caches back
+
+  auto handed_over = pool.acquire(); // Across threads: acquired here, returned there
+  std::thread([h = std::move(handed_over)]() mutable { h.reset(); }).join();
+  EXPECT_EQ(pool.stats().returns, 80001);
+}
+
+TEST_F(ObjectPoolTest, ThreadOutlivingThePool) {
+  auto pool = my::make_unique<ObjectPool<Buffer>>();
+  std::atomic<bool> used {false};
+  std::atomic<bool> go {false};
+  std::thread worker ([&]() {
+    pool->acquire(); // Leaves the object in this thread's cache
+    used = true;
+    while (!go) {
+      std::this_thread::yield();
+    }
+  });
+  while (!used) {
+    std::this_thread::yield();
+  }
+  pool.reset(); // Destroys the worker's cached object too
+  EXPECT_EQ(Buffer::destroyed.load(), 1);
+  go = true;
+  worker.join(); // Its exit must not hand the cache back to the dead pool
+}
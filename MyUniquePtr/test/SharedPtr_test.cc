@@ -0,0 +1,147 @@
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../SharedPtr.h"
+
+using my::SharedPtr;
+using my::WeakPtr;
+
+struct Tracked {
+  static int alive;
+
+  int value;
+
+  explicit Tracked(int v)
+  : value(v) { alive++; }
+
+  virtual ~Tracked() { alive--; }
+};
+
+int Tracked::alive = 0;
+
+struct Derived : Tracked {
+  using Tracked::Tracked;
+  int extra = 7;
+};
+
+template <typename Policy>
+class SharedPtrTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Tracked::alive = 0; }
+  void TearDown() override { EXPECT_EQ(Tracked::alive, 0); }
+};
+
+using Policies = ::testing::Types<my::AtomicCount, my::LocalCount>;
+TYPED_TEST_SUITE(SharedPtrTest, Policies);
+
+TYPED_TEST(SharedPtrTest, CopiesShareOwnership) {
+  SharedPtr<Tracked, TypeParam> a (new Tracked(1));
+  EXPECT_EQ(a.use_count(), 1);
+  {
+    SharedPtr<Tracked, TypeParam> b = a;
+    SharedPtr<Tracked, TypeParam> c;
+    c = b;
+    EXPECT_EQ(a.use_count(), 3);
+    EXPECT_EQ(c->value, 1);
+    EXPECT_EQ(a, c);
+  }
+  EXPECT_EQ(a.use_count(), 1);
+  SharedPtr<Tracked, TypeParam> moved = std::move(a);
+  EXPECT_FALSE(a);
+  EXPECT_EQ(a.use_count(), 0);
+  EXPECT_EQ(moved.use_count(), 1);
+  moved.reset();
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TYPED_TEST(SharedPtrTest, MakeSharedIsOneBlock) {
+  auto p = my::make_shared<Tracked, TypeParam>(5);
+  EXPECT_EQ(p->value, 5);
+  EXPECT_EQ(p.use_count(), 1);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p.get()) % alignof(Tracked), 0);
+  auto s = my::make_shared<std::string, TypeParam>(3, 'z');
+  EXPECT_EQ(*s, "zzz");
+}
+
+TYPED_TEST(SharedPtrTest, WeakPtrLocksUntilLastOwnerGoes) {
+  WeakPtr<Tracked, TypeParam> weak;
+  EXPECT_TRUE(weak.expired());
+  {
+    auto strong = my::make_shared<Tracked, TypeParam>(2);
+    weak = strong;
+    EXPECT_EQ(weak.use_count(), 1);
+    auto locked = weak.lock();
+    ASSERT_TRUE(locked);
+    EXPECT_EQ(locked->value, 2);
+    EXPECT_EQ(strong.use_count(), 2);
+  }
+  EXPECT_EQ(Tracked::alive, 0); // Gone while the weak reference remains
+  EXPECT_TRUE(weak.expired());
+  EXPECT_FALSE(weak.lock());
+  EXPECT_THROW((SharedPtr<Tracked, TypeParam>(weak)), std::bad_weak_ptr);
+}
+
+TYPED_TEST(SharedPtrTest, AliasingConstructor) {
+  SharedPtr<int, TypeParam> member;
+  {
+    auto owner = my::make_shared<Derived, TypeParam>(3);
+    member = SharedPtr<int, TypeParam>(owner, &owner->extra);
+    EXPECT_EQ(owner.use_count(), 2);
+    EXPECT_FALSE(owner.owner_before(member) || member.owner_before(owner));
+  }
+  EXPECT_EQ(Tracked::alive, 1); // Kept alive through the alias
+  EXPECT_EQ(*member, 7);
+  member.reset();
+}
+
+TYPED_TEST(SharedPtrTest, ConvertsToBase) {
+  SharedPtr<Derived, TypeParam> derived = my::make_shared<Derived, TypeParam>(4);
+  SharedPtr<Tracked, TypeParam> base = derived;
+  EXPECT_EQ(base.use_count(), 2);
+  EXPECT_EQ(base->value, 4);
+  derived.reset();
+  base.reset(); // Virtual destructor through the base pointer
+}
+
+TYPED_TEST(SharedPtrTest, FromUniquePtrKeepsDeleter) {
+  int deleted {0};
+  auto counted = [&deleted](Tracked* p) { deleted++; delete p; };
+  {
+    my::UniquePtr<Tracked, decltype(counted)> unique (new Tracked(6), counted);
+    SharedPtr<Tracked, TypeParam> shared = std::move(unique);
+    EXPECT_EQ(unique.get(), nullptr);
+    EXPECT_EQ(shared->value, 6);
+    SharedPtr<Tracked, TypeParam> plain = my::UniquePtr<Tracked>(new Tracked(8));
+    EXPECT_EQ(plain->value, 8);
+    SharedPtr<Tracked, TypeParam> empty = my::UniquePtr<Tracked>();
+    EXPECT_FALSE(empty);
+    EXPECT_EQ(empty.use_count(), 0);
+  }
+  EXPECT_EQ(deleted, 1);
+}
+
+TEST(SharedPtrAtomic, CopiesAcrossThreads) {
+  Tracked::alive = 0;
+  auto shared = my::make_shared<Tracked>(9);
+  WeakPtr<Tracked> weak = shared;
+  std::vector<std::thread> threads;
+  for (int t {0}; t < 4; t++) {
+    threads.emplace_back([shared, weak]() {
+      for (int i {0}; i < 10000; i++) {
+        SharedPtr<Tracked> copy = shared;
+        SharedPtr<Tracked> locked = weak.lock();
+        EXPECT_EQ(locked->value, 9);
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+  shared.reset();
+  EXPECT_EQ(Tracked::alive, 0);
+}
@@ -0,0 +1,175 @@
+#ifndef MY_BUFFER_CACHE_H
+#define MY_BUFFER_CACHE_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace my {
+
+// Counters of the calling thread's recycling cache
+struct RecycleStats {
+  std::size_t hits = 0;         // Allocations served from the cache
+  std::size_t misses = 0;       // Allocations that went to operator new
+  std::size_t parked = 0;       // Freed blocks kept for reuse
+  std::size_t dropped = 0;      // Freed blocks deleted because of the budget
+  std::size_t cached_bytes = 0; // Bytes currently parked
+};
+
+namespace detail {
+
+inline constexpr std::size_t kMaxCachedTypes = 64;
+
+// Per thread switch, budget and counters shared by the caches of all types
+struct RecycleState {
+  bool enabled = false;
+  std::size_t budget = 0;
+  RecycleStats stats;
+  std::size_t (*trimmers[kMaxCachedTypes])(std::size_t keep);
+  std::size_t trimmer_count = 0;
+};
+
+inline thread_local RecycleState recycle_state;
+
+// Thread local free lists of MyVector blocks for one element type, bucketed
+// by power of two capacity. A parked block is threaded onto its bucket
+// through its own first bytes, so parking and taking never allocate.
+// Only used for trivially copyable types, where a block's stale contents
+// are harmless and nothing needs destroying before reuse.
+template <typename T>
+class BufferCache {
+ public:
+  static constexpr std::size_t kBuckets = 48;
+  static constexpr std::size_t kMinCapacity = (sizeof(T*) + sizeof(T) - 1) / sizeof(T);
+
+  static BufferCache &Instance() {
+    static thread_local BufferCache cache;
+    return cache;
+  }
+
+  // Smallest size class holding n elements
+  static std::size_t RoundUp(std::size_t n) {
+    std::size_t cap = kMinCapacity;
+    while (cap < n) {
+      cap *= 2;
+    }
+    return cap;
+  }
+
+  // A parked block of exactly cap elements, or nullptr
+  T* Take(std::size_t cap) {
+    std::size_t b = Bucket(cap);
+    if (b >= kBuckets || heads_[b] == nullptr) {
+      recycle_state.stats.misses++;
+      return nullptr;
+    }
+    T* block = heads_[b];
+    std::memcpy(&heads_[b], static_cast<void*>(block), sizeof(T*));
+    recycle_state.stats.hits++;
+    recycle_state.stats.cached_bytes -= cap * sizeof(T);
+    return block;
+  }
+
+  // Keeps block for reuse if its size class and the budget allow, otherwise
+  // deletes it
+  void Park(T* block, std::size_t cap) {
+    std::size_t b = Bucket(cap);
+    std::size_t bytes = cap * sizeof(T);
+    if (!recycle_state.enabled || b >= kBuckets || (std::size_t(1) << b) * kMinCapacity != cap ||
+        recycle_state.stats.cached_bytes + bytes > recycle_state.budget) {
+      recycle_state.stats.dropped++;
+      delete [] block;
+      return;
+    }
+    std::memcpy(static_cast<void*>(block), &heads_[b], sizeof(T*));
+    heads_[b] = block;
+    recycle_state.stats.parked++;
+    recycle_state.stats.cached_bytes += bytes;
+  }
+
+  // Frees parked blocks, largest first, until at most keep bytes remain
+  static std::size_t Trim(std::size_t keep) {
+    return Instance().TrimBuckets(keep);
+  }
+
+  ~BufferCache() {
+    TrimBuckets(0);
+  }
+
+ private:
+  BufferCache() {
+    if (recycle_state.trimmer_count < kMaxCachedTypes) {
+      recycle_state.trimmers[recycle_state.trimmer_count++] = &BufferCache::Trim;
+    }
+  }
+
+  std::size_t TrimBuckets(std::size_t keep) {
+    std::size_t freed {0};
+    for (std::size_t b {kBuckets}; b-- > 0 && recycle_state.stats.cached_bytes > keep;) {
+      std::size_t bytes = (std::size_t(1) << b) * kMinCapacity * sizeof(T);
+      while (heads_[b] != nullptr && recycle_state.stats.cached_bytes > keep) {
+        T* block = heads_[b];
+        std::memcpy(&heads_[b], static_cast<void*>(block), sizeof(T*));
+        delete [] block;
+        recycle_state.stats.cached_bytes -= bytes;
+        freed += bytes;
+      }
+    }
+    return freed;
+  }
+
+  static std::size_t Bucket(std::size_t cap) {
+    std::size_t b {0};
+    while ((std::size_t(1) << b) * kMinCapacity < cap) {
+      b++;
+    }
+    return b;
+  }
+
+  T* heads_[kBuckets] = {};
+};
+
+} // namespace detail
+
+// Opt-in recycling of MyVector buffers on the calling thread. While enabled,
+// MyVectors of trivially copyable types round their capacity up to a power
+// of two, take blocks from the thread's cache before calling operator new,
+// and park freed blocks there as long as the cache stays within budget
+// bytes. A block is returned to the cache of the thread that frees it.
+class BufferRecycler {
+ public:
+  static void enable(std::size_t budget_bytes = std::size_t(1) << 24) {
+    detail::recycle_state.enabled = true;
+    detail::recycle_state.budget = budget_bytes;
+  }
+
+  // Stops recycling and frees everything parked
+  static void disable() {
+    detail::recycle_state.enabled = false;
+    trim(0);
+  }
+
+  static bool enabled() { return detail::recycle_state.enabled; }
+
+  // Frees parked blocks until at most keep_bytes remain; returns bytes freed
+  static std::size_t trim(std::size_t keep_bytes = 0) {
+    std::size_t freed {0};
+    for (std::size_t i {0}; i < detail::recycle_state.trimmer_count; i++) {
+      freed += detail::recycle_state.trimmers[i](keep_bytes);
+    }
+    return freed;
+  }
+
+  static RecycleStats stats() { return detail::recycle_state.stats; }
+
+  static void reset_stats() {
+    std::size_t cached = detail::recycle_state.stats.cached_bytes;
+    detail::recycle_state.stats = RecycleStats();
+    detail::recycle_state.stats.cached_bytes = cached;
+  }
+};
+
+} // Namespace bracket
+
+#endif
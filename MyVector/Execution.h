@@ -0,0 +1,132 @@
+#ifndef MY_EXECUTION_H
+#define MY_EXECUTION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace my {
+
+// Execution policy accepted by the parallel MyVector overloads. threads == 0
+// uses every hardware thread.
+struct parallel_policy {
+  unsigned threads = 0;
+};
+
+inline constexpr parallel_policy par {};
+
+namespace detail {
+
+// Ranges smaller than this are filled on the calling thread; spawning
+// workers costs more than it saves.
+inline constexpr std::size_t kParallelMinBytes = std::size_t(1) << 20;
+inline constexpr std::size_t kPageBytes = 4096;
+
+// Splits [0, n), the indices of first[0, n), into one contiguous chunk per
+// worker and runs fn(begin, end) on each, with the caller taking the first
+// chunk and, if a worker fails to start, every chunk from there on. Every
+// border but 0 is moved up to the first element that starts on a page
+// boundary, so when fn is the first write to freshly allocated memory each
+// page is faulted in (and placed on a NUMA node) by one worker. Only an
+// element straddling a border, possible when sizeof(T) does not divide the
+// page size, has its pages touched by two.
+template <typename T, typename Function>
+void ParallelFor(const parallel_policy &policy, const T* first, std::size_t n, Function fn) {
+  std::size_t threads = policy.threads ? policy.threads : std::thread::hardware_concurrency();
+  if (threads <= 1 || n * sizeof(T) < kParallelMinBytes) {
+    fn(std::size_t(0), n);
+    return;
+  }
+  std::uintptr_t base = reinterpret_cast<std::uintptr_t>(first);
+  std::size_t chunk = (n + threads - 1) / threads;
+  auto border = [&](std::size_t t) -> std::size_t {
+    if (t == 0) {
+      return 0;
+    }
+    if (t * chunk >= n) {
+      return n;
+    }
+    std::uintptr_t page = (base + t * chunk * sizeof(T) + kPageBytes - 1) / kPageBytes * kPageBytes;
+    return std::min(n, (page - base + sizeof(T) - 1) / sizeof(T));
+  };
+
+  std::vector<std::thread> workers;
+  std::vector<std::exception_ptr> errors(threads);
+  workers.reserve(threads - 1);
+  std::size_t rest = n; // Start of the chunks no worker could be started for
+  for (std::size_t t {1}; t < threads && border(t) < n; t++) {
+    std::size_t begin = border(t);
+    std::size_t end = border(t + 1);
+    if (begin == end) {
+      continue;
+    }
+    try {
+      workers.emplace_back([&, t, begin, end]() {
+        try {
+          fn(begin, end);
+        } catch (...) {
+          errors[t] = std::current_exception();
+        }
+      });
+    } catch (...) { // Out of threads or memory: the caller runs what is left
+      rest = begin;
+      break;
+    }
+  }
+  try {
+    fn(std::size_t(0), border(1));
+    if (rest < n) {
+      fn(rest, n);
+    }
+  } catch (...) {
+    errors[0] = std::current_exception();
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  for (auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+// Whether every byte of value is the same, in which case memset can fill it
+template <typename T>
+bool IsByteRepeat(const T &value) {
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+  for (std::size_t i {1}; i < sizeof(T); i++) {
+    if (bytes[i] != bytes[0]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Fills [first, first + n) with value across the workers of policy
+template <typename T>
+void ParallelFill(const parallel_policy &policy, T* first, std::size_t n, const T &value) {
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    if (IsByteRepeat(value)) {
+      unsigned char byte = *reinterpret_cast<const unsigned char*>(&value);
+      ParallelFor(policy, first, n, [&](std::size_t begin, std::size_t end) {
+        std::memset(static_cast<void*>(first + begin), byte, (end - begin) * sizeof(T));
+      });
+      return;
+    }
+  }
+  ParallelFor(policy, first, n, [&](std::size_t begin, std::size_t end) {
+    std::fill(first + begin, first + end, value);
+  });
+}
+
+} // namespace detail
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef MY_HASH_BYTES_H
+#define MY_HASH_BYTES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace my {
+
+namespace detail {
+
+// Fast non-cryptographic hashing of byte ranges in the style of wyhash:
+// every 16 input bytes cost one 64x64->128 bit multiply, folded back to 64
+// bits. Not stable across versions, so never persist the values.
+
+inline constexpr std::uint64_t kHashSecret[4] = {
+  0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+};
+
+inline std::uint64_t Mum(std::uint64_t a, std::uint64_t b) {
+  __uint128_t r = static_cast<__uint128_t>(a) * b;
+  return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+}
+
+inline std::uint64_t Read8(const unsigned char* p) {
+  std::uint64_t v;
+  std::memcpy(&v, p, 8);
+  return v;
+}
+
+inline std::uint64_t Read4(const unsigned char* p) {
+  std::uint32_t v;
+  std::memcpy(&v, p, 4);
+  return v;
+}
+
+inline std::uint64_t HashBytes(const void* data, std::size_t len, std::uint64_t seed = 0) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  const std::uint64_t* s = kHashSecret;
+  seed ^= Mum(seed ^ s[0], s[1]);
+  std::uint64_t a, b;
+  if (len <= 16) {
+    if (len >= 4) { // Two overlapping reads of 4 bytes from each end
+      std::size_t mid = (len >> 3) << 2;
+      a = (Read4(p) << 32) | Read4(p + mid);
+      b = (Read4(p + len - 4) << 32) | Read4(p + len - 4 - mid);
+    } else if (len > 0) {
+      a = (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[len >> 1]) << 8) | p[len - 1];
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    std::size_t i = len;
+    if (i > 48) { // Three independent lanes so the multiplies overlap
+      std::uint64_t lane1 = seed, lane2 = seed;
+      do {
+        seed = Mum(Read8(p) ^ s[1], Read8(p + 8) ^ seed);
+        lane1 = Mum(Read8(p + 16) ^ s[2], Read8(p + 24) ^ lane1);
+        lane2 = Mum(Read8(p + 32) ^ s[3], Read8(p + 40) ^ lane2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= lane1 ^ lane2;
+    }
+    while (i > 16) {
+      seed = Mum(Read8(p) ^ s[1], Read8(p + 8) ^ seed);
+      p += 16;
+      i -= 16;
+    }
+    a = Read8(p + i - 16); // The last 16 bytes, overlapping what came before
+    b = Read8(p + i - 8);
+  }
+  a ^= s[1];
+  b ^= seed;
+  __uint128_t r = static_cast<__uint128_t>(a) * b;
+  a = static_cast<std::uint64_t>(r);
+  b = static_cast<std::uint64_t>(r >> 64);
+  return Mum(a ^ s[0] ^ len, b ^ s[1]);
+}
+
+// Folds one more 64 bit value into a running hash
+inline std::uint64_t HashCombine(std::uint64_t seed, std::uint64_t value) {
+  return Mum(seed ^ kHashSecret[0], value ^ kHashSecret[1]);
+}
+
+} // namespace detail
+
+} // Namespace bracket
+
+#endif
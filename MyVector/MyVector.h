@@ -1,13 +1,23 @@
 #ifndef MY_VECTOR_H
 #define MY_VECTOR_H
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <exception>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
+
+#include "BufferCache.h"
+#include "Execution.h"
+#include "HashBytes.h"
+#include "TrimRegistry.h"
 
 template <typename T>
 class MyVectorReverseIterator;
@@ -154,7 +164,7 @@ public:
   MyVector(std::initializer_list<T> elements) { // Using initializer list
     size_ = elements.size();
     capacity_ = elements.size();
-    data_ = std::make_unique<ValueType[]>(capacity_);
+    data_ = AllocateBlock(capacity_);
     int counter {0};
     for (auto x : elements) {
       data_[counter] = std::move(x);
@@ -165,34 +175,53 @@ public:
   explicit MyVector(const MyVector<T> &rhs) { // Copy Constructor
     size_ = rhs.size_;
     capacity_ = rhs.capacity_;
-    data_ = std::make_unique<ValueType[]>(capacity_);
+    data_ = AllocateBlock(capacity_);
     for (std::size_t i {0}; i < size_; i++) {
         data_[i] = rhs.data_[i];
     }
   }
 
   MyVector(MyVector<T> &&rhs) { // Move constructor
-    size_ = std::move(rhs.size_);
-    capacity_ = std::move(rhs.capacity_);
+    size_ = rhs.size_;
+    capacity_ = rhs.capacity_;
     data_ = std::move(rhs.data_);
-    rhs.~MyVector();
+    bool trimmable = rhs.trimmable_;
+    rhs.LeaveEmpty();
+    set_trimmable(trimmable); // Registration moves with the buffer
   };
 
   MyVector(int n) { // Size of vector
     size_ = n;
     capacity_ = n;
+    data_ = AllocateBlock(capacity_);
+    if (my::BufferRecycler::enabled()) { // Recycled blocks are not zeroed
+      for (std::size_t i {0}; i < size_; i++) {
+        data_[i] = ValueType();
+      }
+    }
   }
 
   MyVector(std::size_t n, ValueType value) { // Copies of specified element
     size_ = n;
     capacity_ = n;
+    data_ = AllocateBlock(capacity_);
     for (std::size_t i {0}; i < n; i++) {
         data_[i] = value;
     }
   };
 
+  // Copies of specified element, filled by the workers of policy so each
+  // one first-touches its own pages
+  MyVector(const my::parallel_policy &policy, std::size_t n, const ValueType &value) {
+    size_ = n;
+    capacity_ = n;
+    data_ = AllocateForOverwrite(capacity_);
+    my::detail::ParallelFill(policy, data_.get(), n, value);
+  }
+
   virtual ~MyVector() { // Just to make sure data_ gets deleted
-    data_.reset(nullptr);
+    set_trimmable(false);
+    ReleaseBlock(data_, capacity_);
     size_ = 0;
     capacity_ = 0;
   }; 
@@ -210,6 +239,9 @@ public:
   PointerType back() const { // Return pointer to the last element
     return &data_[size_-1];
   }
+  PointerType data() const { // Return pointer to the underlying buffer
+    return data_.get();
+  }
 
   // Iterators
   Iterator begin() {
@@ -248,37 +280,72 @@ public:
 
   void reserve(std::size_t cap) {
     if (cap > capacity_) {
-      capacity_ = cap;
-      std::unique_ptr<ValueType[]> tempBlock = std::make_unique<ValueType[]>(capacity_);
+      std::unique_ptr<ValueType[]> tempBlock = AllocateBlock(cap);
       for (std::size_t i {0}; i < size_; i++) {
         tempBlock[i] = data_[i];
       }
       data_.swap(tempBlock);
+      ReleaseBlock(tempBlock, capacity_);
+      std::size_t grown = cap - capacity_;
+      capacity_ = cap;
+      my::detail::TrimRegistry::Instance().NoteGrowth(grown * sizeof(ValueType));
     }
   };
 
+  // Reallocates to exactly size() elements (with buffer recycling on, the
+  // smallest size class holding them) and frees the old block
   void shrink_to_fit() {
-      capacity_ = size_;
+    if (capacity_ > size_) {
+      Relocate(size_);
+    }
   };
 
+  // Shrink with hysteresis: only when under a quarter of the capacity is in
+  // use, and then to twice the size, so a vector that shrinks and regrows
+  // around the same size is not reallocated every time. The old block is
+  // freed even with buffer recycling on. Returns the bytes given back.
+  std::size_t trim() {
+    if (capacity_ == 0 || size_ * kTrimRatio > capacity_) {
+      return 0;
+    }
+    std::size_t old_capacity = capacity_;
+    Relocate(size_ * 2, false);
+    return old_capacity > capacity_ ? (old_capacity - capacity_) * sizeof(ValueType) : 0;
+  }
+
+  // Opts this vector in or out of trimming by my::trim_all() and by the
+  // RSS budget through my::trim_if_over_budget() (see TrimRegistry.h)
+  void set_trimmable(bool on = true) {
+    if (on == trimmable_) {
+      return;
+    }
+    trimmable_ = on;
+    if (on) {
+      my::detail::TrimRegistry::Instance().Add(this, &MyVector::TrimThunk);
+    } else {
+      my::detail::TrimRegistry::Instance().Remove(this);
+    }
+  }
+
+  bool trimmable() const { return trimmable_; }
+
   // Modifier Methods
   void clear() {
     for (std::size_t i {0}; i < size_; i++) {
-      data_[i].~T();
+      data_[i] = ValueType(); // Slots stay owned by data_, so reset instead of destroying
     }
     size_ = 0;
   };
 
   ReverseIterator insert(Iterator pos, const ValueType& val) {
     size_++;
-    if (capacity_ == 0) { capacity_ = 1; }
     if (size_ > capacity_) {
       int counter {0};
       while (pos != this->begin()) {
         pos--;
         counter++;
       }
-      ReAlloc(capacity_ * 2); 
+      ReAlloc(capacity_ == 0 ? 1 : capacity_ * 2);
       pos = this->begin()+counter;
     }
     for (auto it {this->rbegin()}; it != this->rend(); it++) {
@@ -294,14 +361,13 @@ public:
 
   ReverseIterator insert(Iterator pos, ValueType&& val) {
     size_++;
-    if (capacity_ == 0) { capacity_ = 1; }
     if (size_ > capacity_) {
       int counter {0};
       while (pos != this->begin()) {
         pos--;
         counter++;
       }
-      ReAlloc(capacity_ * 2); 
+      ReAlloc(capacity_ == 0 ? 1 : capacity_ * 2);
       pos = this->begin()+counter;
     }
     for (auto it {this->rbegin()}; it != this->rend(); it++) {
@@ -349,18 +415,16 @@ public:
 
   void push_back(const ValueType &element) {
     size_++;
-    if (capacity_ == 0) { capacity_++; }
     if (size_ > capacity_) {
-        ReAlloc(capacity_ * 2);
+      ReAlloc(capacity_ == 0 ? 1 : capacity_ * 2);
     }
     data_[size_-1] = element;
   };
 
   void push_back(ValueType&& element) {
     size_++;
-    if (capacity_ == 0) {capacity_++;}
     if (size_ > capacity_) {
-      ReAlloc(capacity_ * 2);
+      ReAlloc(capacity_ == 0 ? 1 : capacity_ * 2);
     }
     data_[size_-1] = std::move(element);
   }
@@ -372,36 +436,107 @@ public:
 
   void pop_back() {
     size_--;
-    data_[size_].~T();
+    data_[size_] = ValueType();
   };
 
   void resize(std::size_t count) {
-    if (count > size_) {
-      std::size_t tmp = size_;
-      size_ = count;
-      ReAlloc(size_);
-      for (std::size_t i {tmp}; i < count; i++) {
-        data_[i] = 0;
-      }
-    } else {
-      for (std::size_t i {1}; i < count; i++) {
-        this->pop_back();
-      }
-      size_ = count;
+    resize(count, ValueType());
+  };
+
+  void resize(std::size_t count, const ValueType &value) {
+    if (count > capacity_) {
+      reserve(count > capacity_ * 2 ? count : capacity_ * 2);
+    }
+    for (std::size_t i {size_}; i < count; i++) {
+      data_[i] = value;
+    }
+    for (std::size_t i {count}; i < size_; i++) {
+      data_[i] = ValueType();
     }
+    size_ = count;
+  };
+
+  // Growing resize where a fresh block is first-touched by the workers of
+  // policy: existing elements are moved and the new tail filled in parallel
+  void resize(const my::parallel_policy &policy, std::size_t count, const ValueType &value = ValueType()) {
+    if (count <= size_) {
+      resize(count, value);
+      return;
+    }
+    if (count > capacity_) {
+      std::unique_ptr<ValueType[]> tempBlock = AllocateForOverwrite(count);
+      ValueType* from = data_.get();
+      ValueType* to = tempBlock.get();
+      my::detail::ParallelFor(policy, to, size_, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i {begin}; i < end; i++) {
+          to[i] = std::move(from[i]);
+        }
+      });
+      data_.swap(tempBlock);
+      ReleaseBlock(tempBlock, capacity_);
+      std::size_t grown = count - capacity_;
+      capacity_ = count;
+      my::detail::TrimRegistry::Instance().NoteGrowth(grown * sizeof(ValueType));
+    }
+    my::detail::ParallelFill(policy, data_.get() + size_, count - size_, value);
+    size_ = count;
+  };
+
+  void assign(std::size_t count, const ValueType &value) {
+    if (count > capacity_) {
+      std::size_t cap = count;
+      std::unique_ptr<ValueType[]> tempBlock = AllocateBlock(cap);
+      data_.swap(tempBlock);
+      ReleaseBlock(tempBlock, capacity_);
+      std::size_t grown = cap - capacity_;
+      capacity_ = cap;
+      my::detail::TrimRegistry::Instance().NoteGrowth(grown * sizeof(ValueType));
+    }
+    for (std::size_t i {0}; i < count; i++) {
+      data_[i] = value;
+    }
+    for (std::size_t i {count}; i < size_; i++) {
+      data_[i] = ValueType();
+    }
+    size_ = count;
+  };
+
+  // Replaces the contents with count copies of value. A block that has to
+  // grow is replaced outright (nothing needs to survive), so the parallel
+  // fill is also its first touch.
+  void assign(const my::parallel_policy &policy, std::size_t count, const ValueType &value) {
+    if (count > capacity_) {
+      std::unique_ptr<ValueType[]> tempBlock = AllocateForOverwrite(count);
+      data_.swap(tempBlock);
+      ReleaseBlock(tempBlock, capacity_);
+      std::size_t grown = count - capacity_;
+      capacity_ = count;
+      my::detail::TrimRegistry::Instance().NoteGrowth(grown * sizeof(ValueType));
+    }
+    for (std::size_t i {count}; i < size_; i++) {
+      data_[i] = ValueType();
+    }
+    my::detail::ParallelFill(policy, data_.get(), count, value);
+    size_ = count;
   };
 
   // Operators 
-  MyVector<T> &operator=(const MyVector<T> rhs) { // Copy assignment operator
+  MyVector<T> &operator=(const MyVector<T> &rhs) { // Copy assignment operator
     if (this == &rhs) {
       return *this;
     }
-    data_.reset(nullptr);
+    std::size_t cap = rhs.capacity_;
+    std::unique_ptr<ValueType[]> tempBlock = AllocateBlock(cap);
+    for (std::size_t i {0}; i < rhs.size_; i++) {
+      tempBlock[i] = rhs.data_[i];
+    }
+    data_.swap(tempBlock);
+    ReleaseBlock(tempBlock, capacity_);
+    std::size_t grown = cap > capacity_ ? cap - capacity_ : 0;
     size_ = rhs.size_;
-    capacity_ = rhs.capacity_;
-    data_ = std::make_unique<ValueType[]>(capacity_);
-    for (std::size_t i {0}; i < size_; i++) {
-      data_[i] = rhs.data_[i];
+    capacity_ = cap;
+    if (grown > 0) {
+      my::detail::TrimRegistry::Instance().NoteGrowth(grown * sizeof(ValueType));
     }
     return *this;
   }
@@ -410,10 +545,15 @@ public:
     if (this == &rhs) {
       return *this;
     }
-    size_ = std::move(rhs.size_);
-    capacity_ = std::move(capacity_);
+    ReleaseBlock(data_, capacity_);
+    size_ = rhs.size_;
+    capacity_ = rhs.capacity_;
     data_ = std::move(rhs.data_);
-    rhs.~MyVector();
+    bool trimmable = rhs.trimmable_;
+    rhs.LeaveEmpty();
+    if (trimmable) {
+      set_trimmable(true);
+    }
     return *this;
   }
 
@@ -444,16 +584,190 @@ public:
  private:
   std::size_t size_ = 0; // Number of elements in vector
   std::size_t capacity_ = 0; // Total current capacity available
-  std::unique_ptr<T[]> data_ = std::make_unique<T[]>(capacity_);
-  void ReAlloc(std::size_t new_cap) {
+  std::unique_ptr<T[]> data_; // Empty until the first allocation
+  bool trimmable_ = false; // Registered with the trim registry
+
+  static constexpr std::size_t kTrimRatio = 4;
+
+  // State of a moved from vector: empty, holding no block and no longer
+  // registered, but still usable
+  void LeaveEmpty() {
+    set_trimmable(false);
+    data_.reset(nullptr);
+    size_ = 0;
+    capacity_ = 0;
+  }
+
+  static std::size_t TrimThunk(void* vector) {
+    return static_cast<MyVector<T>*>(vector)->trim();
+  }
+
+  // Moves the elements into a block of new_cap >= size_ elements, or drops
+  // the block when new_cap is 0. The old block is parked in the recycling
+  // cache when park is set, and deleted otherwise.
+  void Relocate(std::size_t new_cap, bool park = true) {
+    std::unique_ptr<ValueType[]> tempBlock;
+    if (new_cap > 0) {
+      tempBlock = AllocateBlock(new_cap);
+      for (std::size_t i {0}; i < size_; i++) {
+        tempBlock[i] = std::move(data_[i]);
+      }
+    }
+    data_.swap(tempBlock);
+    if (park) {
+      ReleaseBlock(tempBlock, capacity_);
+    } else {
+      tempBlock.reset(nullptr);
+    }
     capacity_ = new_cap;
-    std::unique_ptr<ValueType[]> tempBlock = std::make_unique<ValueType[]>(capacity_);
+  }
+
+  void ReAlloc(std::size_t new_cap) {
+    std::unique_ptr<ValueType[]> tempBlock = AllocateBlock(new_cap);
     for (std::size_t i {0}; i < size_-1; i++) {
         tempBlock[i] = std::move(data_[i]);
     }
     data_.swap(tempBlock);
-    // tempBlock goes out of scope here and gets garbage collected
+    ReleaseBlock(tempBlock, capacity_);
+    std::size_t grown = new_cap - capacity_;
+    capacity_ = new_cap;
+    my::detail::TrimRegistry::Instance().NoteGrowth(grown * sizeof(ValueType));
+  }
+
+  // New block for cap elements. With buffer recycling enabled on this
+  // thread, cap is rounded up to its size class and a parked block is
+  // reused when there is one
+  static std::unique_ptr<ValueType[]> AllocateBlock(std::size_t &cap) {
+    if constexpr (std::is_trivially_copyable<ValueType>::value) {
+      if (my::detail::recycle_state.enabled && cap > 0) {
+        auto &cache = my::detail::BufferCache<ValueType>::Instance();
+        cap = cache.RoundUp(cap);
+        if (ValueType* block = cache.Take(cap)) {
+          return std::unique_ptr<ValueType[]>(block);
+        }
+        return std::unique_ptr<ValueType[]>(new ValueType[cap]);
+      }
+    }
+    return std::make_unique<ValueType[]>(cap);
+  }
+
+  // Frees block, or parks it in the thread's cache while recycling
+  static void ReleaseBlock(std::unique_ptr<ValueType[]> &block, std::size_t cap) {
+    if constexpr (std::is_trivially_copyable<ValueType>::value) {
+      if (block && my::detail::recycle_state.enabled) {
+        my::detail::BufferCache<ValueType>::Instance().Park(block.release(), cap);
+        return;
+      }
+    }
+    block.reset(nullptr);
+  }
+
+  // Default-initialized block: for trivial types the memory is left
+  // untouched, so the pages fault in wherever they are first written
+  static std::unique_ptr<ValueType[]> AllocateForOverwrite(std::size_t n) {
+    return std::unique_ptr<ValueType[]>(new ValueType[n]);
   }
 };
 
+namespace my {
+
+namespace detail {
+
+// Whether a MyVector<T> can be compared and hashed as raw bytes: equal
+// values must have equal bytes and the other way round, which rules out
+// padding and floating point
+template <typename T>
+inline constexpr bool kBytewise = std::has_unique_object_representations<T>::value;
+
+// First index where a and b differ, or n. Equal prefixes are skipped a
+// cache line at a time with memcmp.
+template <typename T>
+std::size_t Mismatch(const T* a, const T* b, std::size_t n) {
+  constexpr std::size_t kChunk = sizeof(T) >= 64 ? 1 : 64 / sizeof(T);
+  std::size_t i {0};
+  while (i + kChunk <= n && std::memcmp(a + i, b + i, kChunk * sizeof(T)) == 0) {
+    i += kChunk;
+  }
+  std::size_t end = i + kChunk < n ? i + kChunk : n;
+  while (i < end && std::memcmp(a + i, b + i, sizeof(T)) == 0) {
+    i++;
+  }
+  return i;
+}
+
+} // namespace detail
+
+} // Namespace bracket
+
+// Comparison Operators. Sizes are checked first; types that are bytewise
+// comparable then go through memcmp, everything else element by element.
+template <typename T>
+bool operator==(const MyVector<T> &lhs, const MyVector<T> &rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  if constexpr (my::detail::kBytewise<T>) {
+    return lhs.size() == 0 || std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(T)) == 0;
+  } else {
+    return std::equal(lhs.data(), lhs.data() + lhs.size(), rhs.data());
+  }
+}
+
+template <typename T>
+bool operator!=(const MyVector<T> &lhs, const MyVector<T> &rhs) {
+  return !(lhs == rhs);
+}
+
+// Lexicographic, like std::vector
+template <typename T>
+bool operator<(const MyVector<T> &lhs, const MyVector<T> &rhs) {
+  std::size_t n = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+  if constexpr (my::detail::kBytewise<T>) {
+    std::size_t i = my::detail::Mismatch(lhs.data(), rhs.data(), n);
+    if (i < n) {
+      return lhs[i] < rhs[i];
+    }
+    return lhs.size() < rhs.size();
+  } else {
+    return std::lexicographical_compare(lhs.data(), lhs.data() + lhs.size(),
+                                        rhs.data(), rhs.data() + rhs.size());
+  }
+}
+
+template <typename T>
+bool operator>(const MyVector<T> &lhs, const MyVector<T> &rhs) {
+  return rhs < lhs;
+}
+
+template <typename T>
+bool operator<=(const MyVector<T> &lhs, const MyVector<T> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename T>
+bool operator>=(const MyVector<T> &lhs, const MyVector<T> &rhs) {
+  return !(lhs < rhs);
+}
+
+// Bytewise comparable elements are hashed as one byte range, anything else
+// by folding in std::hash of every element
+namespace std {
+
+template <typename T>
+struct hash<MyVector<T>> {
+  std::size_t operator()(const MyVector<T> &v) const {
+    if constexpr (my::detail::kBytewise<T>) {
+      return my::detail::HashBytes(v.data(), v.size() * sizeof(T));
+    } else {
+      std::uint64_t h = v.size();
+      for (std::size_t i {0}; i < v.size(); i++) {
+        h = my::detail::HashCombine(h, std::hash<T>()(v[i]));
+      }
+      return h;
+    }
+  }
+};
+
+} // namespace std
+
 #endif
@@ -0,0 +1,189 @@
+#ifndef MY_TRIM_REGISTRY_H
+#define MY_TRIM_REGISTRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+namespace my {
+
+// Totals of the trimming done so far
+struct TrimStats {
+  std::size_t registered = 0;      // Vectors currently registered
+  std::size_t passes = 0;          // trim_all() calls plus budget triggered passes
+  std::size_t reclaimed_bytes = 0; // Bytes given back by all passes
+};
+
+namespace detail {
+
+// Growth between two RSS checks while a budget is set
+inline constexpr std::size_t kTrimCheckBytes = std::size_t(1) << 20;
+
+// Resident set size of the process, or 0 where /proc is not available
+inline std::size_t ResidentBytes() {
+  std::FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (statm == nullptr) {
+    return 0;
+  }
+  unsigned long total {0}, resident {0};
+  int read = std::fscanf(statm, "%lu %lu", &total, &resident);
+  std::fclose(statm);
+  return read == 2 ? resident * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) : 0;
+}
+
+// Process wide set of vectors that agreed to be trimmed, keyed by address.
+// Each entry is type erased to a function trimming the vector, and
+// remembers the thread that registered it.
+class TrimRegistry {
+ public:
+  // Never destroyed, so vectors with static storage can still unregister
+  // during exit
+  static TrimRegistry &Instance() {
+    static TrimRegistry* registry = new TrimRegistry();
+    return *registry;
+  }
+
+  void Add(void* vector, std::size_t (*trim)(void*)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[vector] = Entry {trim, std::this_thread::get_id()};
+  }
+
+  void Remove(void* vector) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(vector);
+  }
+
+  // Trims every entry, or only the calling thread's when own_only. Returns
+  // the bytes given back. The trims run without the lock: a trim relocates
+  // elements, and when those are trimmable vectors themselves, moving them
+  // adds and removes entries.
+  std::size_t Trim(bool own_only) {
+    std::vector<std::pair<void*, Entry>> pass;
+    std::thread::id self = std::this_thread::get_id();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pass.reserve(entries_.size());
+      for (const auto &entry : entries_) {
+        if (!own_only || entry.second.owner == self) {
+          pass.push_back(entry);
+        }
+      }
+    }
+    std::size_t reclaimed {0};
+    for (const auto &entry : pass) {
+      if (Registered(entry.first, entry.second)) { // Not moved or destroyed by an earlier trim of this pass
+        reclaimed += entry.second.trim(entry.first);
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.passes++;
+    stats_.reclaimed_bytes += reclaimed;
+    return reclaimed;
+  }
+
+  // Called after a vector grew by bytes. With a budget set, every
+  // kTrimCheckBytes of growth the RSS is checked, and over budget a trim
+  // of the calling thread's vectors is marked due. It is not run here: the
+  // growing vector may be an element of a registered one, and trimming
+  // that would move the vector in the middle of its own push_back.
+  void NoteGrowth(std::size_t bytes) {
+    std::size_t budget = budget_.load(std::memory_order_relaxed);
+    if (budget == 0) {
+      return;
+    }
+    if (growth_.fetch_add(bytes, std::memory_order_relaxed) + bytes < kTrimCheckBytes) {
+      return;
+    }
+    growth_.store(0, std::memory_order_relaxed);
+    if (ResidentBytes() > budget) {
+      TrimDue() = true;
+    }
+  }
+
+  // Runs the trim NoteGrowth marked due on this thread, if any. Other
+  // threads' vectors are left alone since they may be in use.
+  std::size_t TrimIfDue() {
+    if (!TrimDue()) {
+      return 0;
+    }
+    TrimDue() = false;
+    return Trim(true);
+  }
+
+  void SetBudget(std::size_t bytes) { budget_.store(bytes, std::memory_order_relaxed); }
+
+  std::size_t Budget() const { return budget_.load(std::memory_order_relaxed); }
+
+  TrimStats Stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TrimStats stats = stats_;
+    stats.registered = entries_.size();
+    return stats;
+  }
+
+ private:
+  struct Entry {
+    std::size_t (*trim)(void*);
+    std::thread::id owner;
+  };
+
+  static bool &TrimDue() {
+    thread_local bool due = false;
+    return due;
+  }
+
+  bool Registered(void* vector, const Entry &entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(vector);
+    return it != entries_.end() && it->second.trim == entry.trim;
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<void*, Entry> entries_;
+  TrimStats stats_;
+  std::atomic<std::size_t> budget_ {0};
+  std::atomic<std::size_t> growth_ {0};
+};
+
+} // namespace detail
+
+// Trims every registered vector (see MyVector::set_trimmable); returns the
+// bytes given back. Blocks parked by buffer recycling are left alone (see
+// BufferRecycler::trim). The caller must make sure no other thread is using
+// a registered vector meanwhile.
+inline std::size_t trim_all() {
+  return detail::TrimRegistry::Instance().Trim(false);
+}
+
+// RSS in bytes above which growing vectors mark a trim of the registered
+// vectors of their own thread due; 0 (the default) turns it off
+inline void set_rss_budget(std::size_t bytes) {
+  detail::TrimRegistry::Instance().SetBudget(bytes);
+}
+
+inline std::size_t rss_budget() {
+  return detail::TrimRegistry::Instance().Budget();
+}
+
+// Safe point for the RSS budget: trims the calling thread's registered
+// vectors if growth put the process over budget since the last call, and
+// returns the bytes given back. Call it where none of those vectors is in
+// the middle of a call, e.g. once per request or loop iteration.
+inline std::size_t trim_if_over_budget() {
+  return detail::TrimRegistry::Instance().TrimIfDue();
+}
+
+inline TrimStats trim_stats() {
+  return detail::TrimRegistry::Instance().Stats();
+}
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,66 @@
+#include <cstdint>
+#include <functional>
+#include <benchmark/benchmark.h>
+#include "../MyVector.h"
+
+// Bulk byte hashing and memcmp equality of MyVector<uint32_t> against the
+// element at a time loops they replace.
+
+static MyVector<std::uint32_t> Sequence(std::size_t n) {
+  MyVector<std::uint32_t> v;
+  v.reserve(n);
+  for (std::size_t i {0}; i < n; i++) {
+    v.push_back(static_cast<std::uint32_t>(i * 2654435761u));
+  }
+  return v;
+}
+
+static void BM_HashBulk(benchmark::State &state) {
+  auto v = Sequence(state.range(0));
+  std::hash<MyVector<std::uint32_t>> hasher;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hasher(v));
+  }
+  state.SetBytesProcessed(state.iterations() * v.size() * sizeof(std::uint32_t));
+}
+
+static void BM_HashPerElement(benchmark::State &state) {
+  auto v = Sequence(state.range(0));
+  for (auto _ : state) {
+    std::uint64_t h = v.size();
+    for (std::size_t i {0}; i < v.size(); i++) {
+      h = my::detail::HashCombine(h, std::hash<std::uint32_t>()(v[i]));
+    }
+    benchmark::DoNotOptimize(h);
+  }
+  state.SetBytesProcessed(state.iterations() * v.size() * sizeof(std::uint32_t));
+}
+
+static void BM_EqualMemcmp(benchmark::State &state) {
+  auto a = Sequence(state.range(0));
+  auto b = Sequence(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a == b);
+  }
+  state.SetBytesProcessed(state.iterations() * a.size() * sizeof(std::uint32_t));
+}
+
+static void BM_EqualPerElement(benchmark::State &state) {
+  auto a = Sequence(state.range(0));
+  auto b = Sequence(state.range(0));
+  for (auto _ : state) {
+    bool equal = a.size() == b.size();
+    for (std::size_t i {0}; equal && i < a.size(); i++) {
+      equal = a[i] == b[i];
+    }
+    benchmark::DoNotOptimize(equal);
+  }
+  state.SetBytesProcessed(state.iterations() * a.size() * sizeof(std::uint32_t));
+}
+
+BENCHMARK(BM_HashBulk)->RangeMultiplier(16)->Range(4, 1 << 20);
+BENCHMARK(BM_HashPerElement)->RangeMultiplier(16)->Range(4, 1 << 20);
+BENCHMARK(BM_EqualMemcmp)->RangeMultiplier(16)->Range(4, 1 << 20);
+BENCHMARK(BM_EqualPerElement)->RangeMultiplier(16)->Range(4, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,50 @@
+#include <cstdint>
+#include <new>
+#include <benchmark/benchmark.h>
+#include "../MyVector.h"
+
+// Time until a freshly built MyVector<uint64_t> of the given size in GiB is
+// fully written, comparing the single threaded fill constructor with the
+// parallel first-touch overloads. Each run allocates the full size, so pick
+// sizes that fit the machine (for example --benchmark_filter=/16/).
+
+static const std::size_t kGiB = std::size_t(1) << 30;
+
+template <typename Build>
+static void TimeToReady(benchmark::State &state, Build build) {
+  std::size_t n = state.range(0) * kGiB / sizeof(std::uint64_t);
+  for (auto _ : state) {
+    try {
+      auto mv = build(n);
+      benchmark::DoNotOptimize(mv.data());
+      state.PauseTiming(); // Keep the unmap of the old vector out of the timing
+    } catch (const std::bad_alloc &) {
+      state.SkipWithError("allocation failed");
+      break;
+    }
+    state.ResumeTiming();
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(std::uint64_t));
+}
+
+static void BM_FillConstructor(benchmark::State &state) {
+  TimeToReady(state, [](std::size_t n) { return MyVector<std::uint64_t>(n, std::uint64_t(1)); });
+}
+
+static void BM_ParallelFillConstructor(benchmark::State &state) {
+  TimeToReady(state, [](std::size_t n) { return MyVector<std::uint64_t>(my::par, n, std::uint64_t(1)); });
+}
+
+static void BM_ParallelResize(benchmark::State &state) {
+  TimeToReady(state, [](std::size_t n) {
+    MyVector<std::uint64_t> mv;
+    mv.resize(my::par, n);
+    return mv;
+  });
+}
+
+BENCHMARK(BM_FillConstructor)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK(BM_ParallelFillConstructor)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK(BM_ParallelResize)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+BENCHMARK_MAIN();
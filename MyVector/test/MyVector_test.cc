@@ -1,8 +1,19 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <sys/resource.h>
+#include <unistd.h>
 #include "../MyVector.h"
 
 using std::unique_ptr;
@@ -352,3 +363,410 @@ TEST_F(NonEmptyVectorTestPoint, EmplaceBackMethod) {
 
   VectorTest();
 }
+
+TEST_F(NonEmptyVectorTest, ResizeWithValueMethod) {
+  nonempty_std_v->resize(8, 7);
+  nonempty_my_v->resize(8, 7);
+  VectorTest();
+}
+
+TEST_F(NonEmptyVectorTest, AssignMethod) {
+  nonempty_std_v->assign(3, 9);
+  nonempty_my_v->assign(3, 9);
+  ASSERT_EQ(nonempty_std_v->size(), nonempty_my_v->size());
+  nonempty_std_v->assign(12, 4);
+  nonempty_my_v->assign(12, 4);
+  VectorTest();
+}
+
+// Large enough that the parallel overloads really split the work
+struct ParallelFillTest : testing::Test {
+  const std::size_t n = std::size_t(1) << 20;
+  const my::parallel_policy policy {4};
+};
+
+TEST_F(ParallelFillTest, FillConstructor) {
+  MyVector<int> mv (policy, n, 7);
+  ASSERT_EQ(mv.size(), n);
+  for (std::size_t i {0}; i < n; i++) {
+    ASSERT_EQ(mv[i], 7);
+  }
+}
+
+TEST_F(ParallelFillTest, FillConstructorNonTrivial) {
+  MyVector<std::string> mv (policy, 100000, std::string("abc"));
+  EXPECT_EQ(mv[0], "abc");
+  EXPECT_EQ(mv[99999], "abc");
+}
+
+TEST_F(ParallelFillTest, ResizeMethod) {
+  MyVector<long> mv {1, 2, 3};
+  mv.resize(policy, n, -1);
+  ASSERT_EQ(mv.size(), n);
+  EXPECT_EQ(mv[2], 3);
+  for (std::size_t i {3}; i < n; i++) {
+    ASSERT_EQ(mv[i], -1);
+  }
+  mv.resize(policy, 2);
+  EXPECT_EQ(mv.size(), 2);
+  EXPECT_EQ(mv[1], 2);
+}
+
+TEST_F(ParallelFillTest, AssignMethod) {
+  MyVector<double> mv {1.0, 2.0};
+  mv.assign(policy, n, 0.5);
+  ASSERT_EQ(mv.size(), n);
+  EXPECT_EQ(mv[0], 0.5);
+  EXPECT_EQ(mv[n - 1], 0.5);
+  mv.assign(my::par, 4, 0.0);
+  EXPECT_EQ(mv.size(), 4);
+  EXPECT_EQ(mv[3], 0.0);
+}
+
+TEST_F(ParallelFillTest, AssignKeepsContentsWhenAllocationFails) {
+  MyVector<int> mv {1, 2, 3};
+  std::size_t huge = std::numeric_limits<std::size_t>::max() / 2;
+  EXPECT_THROW(mv.assign(huge, 0), std::bad_alloc);
+  EXPECT_THROW(mv.assign(policy, huge, 0), std::bad_alloc);
+  ASSERT_EQ(mv.size(), 3);
+  EXPECT_EQ(mv[2], 3);
+  mv.push_back(4);
+  EXPECT_EQ(mv[3], 4);
+}
+
+TEST_F(ParallelFillTest, ChunksStartOnPageBoundaries) {
+  std::vector<std::uint32_t> buffer (n + 1024);
+  const std::uint32_t* first = buffer.data() + 3; // Not page aligned
+  std::mutex mutex;
+  std::vector<std::pair<std::size_t, std::size_t>> chunks;
+  my::detail::ParallelFor(policy, first, n, [&](std::size_t begin, std::size_t end) {
+    std::lock_guard<std::mutex> lock(mutex);
+    chunks.emplace_back(begin, end);
+  });
+  std::sort(chunks.begin(), chunks.end());
+  ASSERT_EQ(chunks.size(), 4);
+  EXPECT_EQ(chunks[0].first, 0);
+  EXPECT_EQ(chunks[3].second, n);
+  for (std::size_t i {1}; i < chunks.size(); i++) {
+    EXPECT_EQ(chunks[i].first, chunks[i - 1].second);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first + chunks[i].first) % my::detail::kPageBytes, 0);
+  }
+}
+
+// Address space mapped by the process, from /proc/self/statm
+std::size_t MappedBytes() {
+  unsigned long pages {0};
+  if (std::FILE* statm = std::fopen("/proc/self/statm", "r")) {
+    if (std::fscanf(statm, "%lu", &pages) != 1) {
+      pages = 0;
+    }
+    std::fclose(statm);
+  }
+  return pages * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+// Fills a vector with more workers than the address space has room for
+// stacks, and exits with 0 if every element was written
+void FillWithTooManyWorkers() {
+  rlimit limit {MappedBytes() + (std::size_t(256) << 20), RLIM_INFINITY};
+  ::setrlimit(RLIMIT_AS, &limit);
+  std::size_t count = std::size_t(64) << 20;
+  MyVector<char> mv (my::parallel_policy {2000}, count, 'x');
+  for (std::size_t i {0}; i < count; i++) {
+    if (mv[i] != 'x') {
+      std::exit(1);
+    }
+  }
+  std::exit(0);
+}
+
+// Once starting a worker fails, the calling thread fills the rest instead
+// of the started workers terminating the process
+TEST_F(ParallelFillTest, FallsBackWhenWorkersFailToStart) {
+  EXPECT_EXIT(FillWithTooManyWorkers(), testing::ExitedWithCode(0), "");
+}
+
+// Buffer recycling is per thread, so every test leaves it disabled again
+struct BufferRecyclingTest : testing::Test {
+  BufferRecyclingTest() {
+    my::BufferRecycler::enable(1 << 20);
+    my::BufferRecycler::reset_stats();
+  }
+
+  virtual ~BufferRecyclingTest() {
+    my::BufferRecycler::disable();
+  }
+};
+
+TEST_F(BufferRecyclingTest, ReusesFreedBuffers) {
+  for (int round {0}; round < 10; round++) {
+    MyVector<int> mv;
+    for (int i {0}; i < 100; i++) {
+      mv.push_back(i);
+    }
+    EXPECT_EQ(mv[99], 99);
+  }
+  my::RecycleStats stats = my::BufferRecycler::stats();
+  EXPECT_GT(stats.hits, 10 * stats.misses / 2);
+  EXPECT_GT(stats.cached_bytes, 0);
+}
+
+TEST_F(BufferRecyclingTest, RoundsCapacityToSizeClass) {
+  MyVector<int> mv (5, 3);
+  EXPECT_EQ(mv.size(), 5);
+  EXPECT_EQ(mv.capacity(), 8);
+  mv.assign(20, 1);
+  EXPECT_EQ(mv.size(), 20);
+  EXPECT_EQ(mv[19], 1);
+}
+
+TEST_F(BufferRecyclingTest, SizeConstructorZeroesRecycledBuffer) {
+  { MyVector<int> dirty (16, 7); }
+  MyVector<int> mv (16);
+  for (std::size_t i {0}; i < mv.size(); i++) {
+    EXPECT_EQ(mv[i], 0);
+  }
+}
+
+TEST_F(BufferRecyclingTest, BudgetAndTrim) {
+  my::BufferRecycler::enable(1024);
+  { MyVector<char> big (std::size_t(4096), 'a'); }
+  EXPECT_EQ(my::BufferRecycler::stats().dropped, 1);
+  { MyVector<int> small (std::size_t(64), 1); }
+  EXPECT_EQ(my::BufferRecycler::stats().cached_bytes, 256);
+  EXPECT_EQ(my::BufferRecycler::trim(), 256);
+  EXPECT_EQ(my::BufferRecycler::stats().cached_bytes, 0);
+}
+
+TEST_F(BufferRecyclingTest, NonTrivialTypesBypassCache) {
+  { MyVector<std::string> mv {"a", "b", "c"}; }
+  EXPECT_EQ(my::BufferRecycler::stats().parked, 0);
+}
+
+TEST(VectorComparison, EqualityShortCircuitsOnSize) {
+  MyVector<int> a {1, 2, 3};
+  MyVector<int> b {1, 2, 3};
+  MyVector<int> c {1, 2};
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a != b);
+  EXPECT_TRUE(a != c);
+  b[2] = 4;
+  EXPECT_FALSE(a == b);
+}
+
+TEST(VectorComparison, LexicographicOrderMatchesStd) {
+  std::vector<std::vector<int>> cases {{}, {1}, {1, 2}, {1, 3}, {2}, {-1, 5}};
+  for (int i {0}; i < 200; i++) { // Long enough to cross the memcmp chunks
+    cases.push_back(std::vector<int>(100, 7));
+    cases.back()[i % 100] = i % 3 - 1;
+  }
+  for (const auto &x : cases) {
+    for (const auto &y : cases) {
+      MyVector<int> mx, my;
+      for (int v : x) mx.push_back(v);
+      for (int v : y) my.push_back(v);
+      ASSERT_EQ(mx < my, x < y);
+      ASSERT_EQ(mx <= my, x <= y);
+      ASSERT_EQ(mx > my, x > y);
+      ASSERT_EQ(mx == my, x == y);
+    }
+  }
+}
+
+TEST(VectorComparison, NonBytewiseTypes) {
+  MyVector<double> a {0.0, 1.5};
+  MyVector<double> b {-0.0, 1.5}; // Equal values with different bytes
+  EXPECT_TRUE(a == b);
+  MyVector<std::string> s {"b"};
+  MyVector<std::string> t {"a", "z"};
+  EXPECT_TRUE(t < s);
+}
+
+TEST(VectorHash, EqualVectorsHashEqual) {
+  std::hash<MyVector<std::uint32_t>> hasher;
+  MyVector<std::uint32_t> a;
+  MyVector<std::uint32_t> b;
+  for (std::uint32_t i {0}; i < 1000; i++) {
+    a.push_back(i);
+    b.push_back(i);
+    ASSERT_EQ(hasher(a), hasher(b));
+  }
+  b[500] = 0;
+  EXPECT_NE(hasher(a), hasher(b));
+  MyVector<std::string> s {"x", "y"};
+  MyVector<std::string> t {"x", "y"};
+  EXPECT_EQ(std::hash<MyVector<std::string>>()(s), std::hash<MyVector<std::string>>()(t));
+}
+
+TEST(VectorHash, FewCollisionsOnSmallVectors) {
+  std::hash<MyVector<std::uint8_t>> hasher;
+  std::vector<std::size_t> hashes;
+  for (int len {0}; len < 4; len++) {
+    for (int x {0}; x < 256; x++) {
+      MyVector<std::uint8_t> v;
+      for (int i {0}; i < len; i++) {
+        v.push_back(static_cast<std::uint8_t>(x + i));
+      }
+      hashes.push_back(hasher(v));
+    }
+  }
+  std::sort(hashes.begin(), hashes.end());
+  // Only the 256 copies of the empty vector may share a value
+  EXPECT_EQ(std::unique(hashes.begin(), hashes.end()) - hashes.begin(), 1 + 3 * 256);
+}
+
+TEST(VectorTrimming, ShrinkToFitReallocates) {
+  MyVector<int> mv;
+  mv.reserve(1000);
+  for (int i {0}; i < 10; i++) {
+    mv.push_back(i);
+  }
+  int* before = mv.data();
+  mv.shrink_to_fit();
+  EXPECT_NE(mv.data(), before);
+  EXPECT_EQ(mv.capacity(), 10);
+  mv.push_back(10); // Growth must see the real capacity
+  for (int i {0}; i < 11; i++) {
+    EXPECT_EQ(mv[i], i);
+  }
+  mv.clear();
+  mv.shrink_to_fit();
+  EXPECT_EQ(mv.capacity(), 0);
+}
+
+TEST(VectorTrimming, TrimHysteresis) {
+  MyVector<int> mv;
+  mv.reserve(100);
+  mv.resize(30);
+  EXPECT_EQ(mv.trim(), 0); // Over a quarter in use
+  mv.resize(20);
+  EXPECT_EQ(mv.trim(), 60 * sizeof(int));
+  EXPECT_EQ(mv.capacity(), 40);
+  EXPECT_EQ(mv.trim(), 0); // Already trimmed, stays put
+}
+
+TEST(VectorTrimming, TrimAllReclaimsRegisteredVectors) {
+  std::size_t registered = my::trim_stats().registered;
+  MyVector<std::uint64_t> a;
+  MyVector<std::uint64_t> b;
+  a.reserve(1024);
+  b.reserve(1024);
+  a.set_trimmable();
+  {
+    MyVector<std::uint64_t> c;
+    c.set_trimmable();
+    EXPECT_EQ(my::trim_stats().registered, registered + 2);
+  }
+  EXPECT_EQ(my::trim_stats().registered, registered + 1);
+  EXPECT_EQ(my::trim_all(), 1024 * sizeof(std::uint64_t));
+  EXPECT_EQ(a.capacity(), 0);
+  EXPECT_EQ(b.capacity(), 1024); // Not registered
+}
+
+TEST_F(BufferRecyclingTest, TrimAllCountsFreedBytesOnce) {
+  MyVector<int> mv;
+  mv.reserve(65536);
+  for (int i {0}; i < 10; i++) {
+    mv.push_back(i);
+  }
+  mv.set_trimmable();
+  std::size_t cached = my::BufferRecycler::stats().cached_bytes;
+  std::size_t reclaimed = my::trim_stats().reclaimed_bytes;
+  std::size_t freed = (65536 - 32) * sizeof(int); // Down to the size class of 20
+  EXPECT_EQ(my::trim_all(), freed);
+  EXPECT_EQ(mv.capacity(), 32);
+  EXPECT_EQ(my::trim_stats().reclaimed_bytes - reclaimed, freed);
+  EXPECT_EQ(my::BufferRecycler::stats().cached_bytes, cached); // Old block freed, not parked
+  for (int i {0}; i < 10; i++) {
+    EXPECT_EQ(mv[i], i);
+  }
+}
+
+TEST(VectorTrimming, RegistrationFollowsMoves) {
+  std::size_t registered = my::trim_stats().registered;
+  MyVector<int> a;
+  a.set_trimmable();
+  MyVector<int> b(std::move(a));
+  EXPECT_TRUE(b.trimmable());
+  EXPECT_FALSE(a.trimmable());
+  EXPECT_EQ(my::trim_stats().registered, registered + 1);
+  b.set_trimmable(false);
+  EXPECT_EQ(my::trim_stats().registered, registered);
+}
+
+TEST(VectorTrimming, TrimAllWithNestedTrimmableVectors) {
+  std::size_t registered = my::trim_stats().registered;
+  MyVector<MyVector<int>> outer;
+  outer.reserve(64);
+  outer.set_trimmable();
+  outer.push_back(MyVector<int>());
+  outer[0].reserve(256);
+  outer[0].push_back(7);
+  outer[0].set_trimmable();
+  EXPECT_EQ(my::trim_stats().registered, registered + 2);
+  // Trimming outer moves the inner vector, which unregisters and registers again
+  EXPECT_GT(my::trim_all(), 0);
+  EXPECT_EQ(outer.capacity(), 2);
+  EXPECT_TRUE(outer[0].trimmable());
+  EXPECT_EQ(outer[0][0], 7);
+  EXPECT_EQ(my::trim_stats().registered, registered + 2);
+  my::trim_all(); // Reaches the inner vector at its new address
+  EXPECT_EQ(outer[0].capacity(), 2);
+}
+
+TEST(VectorTrimming, RssBudgetTrimsOwnVectors) {
+  MyVector<char> idle;
+  idle.reserve(1 << 20);
+  idle.set_trimmable();
+  my::set_rss_budget(1); // Always over budget
+  MyVector<char> growing;
+  growing.set_trimmable();
+  growing.reserve(std::size_t(2) << 20); // Past the check interval
+  my::set_rss_budget(0);
+  EXPECT_EQ(idle.capacity(), 1 << 20); // Only marked due while growing
+  EXPECT_GT(my::trim_if_over_budget(), 0);
+  EXPECT_EQ(idle.capacity(), 0);
+  EXPECT_EQ(growing.capacity(), 0);
+  EXPECT_EQ(my::trim_if_over_budget(), 0); // Nothing due any more
+}
+
+TEST(VectorTrimming, RssBudgetSeesEveryGrowthPath) {
+  MyVector<char> idle;
+  idle.reserve(1 << 20);
+  idle.set_trimmable();
+  MyVector<char> big(std::size_t(2) << 20, 'x');
+  my::set_rss_budget(1);
+  MyVector<char> grown;
+  grown.resize(my::par, std::size_t(2) << 20);
+  EXPECT_GT(my::trim_if_over_budget(), 0);
+  idle.reserve(1 << 20);
+  MyVector<char> assigned;
+  assigned.assign(std::size_t(2) << 20, 'y');
+  EXPECT_GT(my::trim_if_over_budget(), 0);
+  idle.reserve(1 << 20);
+  assigned.assign(my::par, std::size_t(4) << 20, 'z');
+  EXPECT_GT(my::trim_if_over_budget(), 0);
+  idle.reserve(1 << 20);
+  MyVector<char> copied;
+  copied = big;
+  my::set_rss_budget(0);
+  EXPECT_GT(my::trim_if_over_budget(), 0);
+  EXPECT_EQ(idle.capacity(), 0);
+}
+
+TEST(VectorTrimming, RssBudgetDoesNotMoveAGrowingElement) {
+  MyVector<MyVector<char>> outer;
+  outer.reserve(64);
+  outer.push_back(MyVector<char>());
+  outer.set_trimmable();
+  my::set_rss_budget(1);
+  for (std::size_t i {0}; i < (std::size_t(4) << 20); i++) {
+    outer[0].push_back('x'); // Trimming outer here would free this element
+  }
+  my::set_rss_budget(0);
+  EXPECT_EQ(outer.capacity(), 64);
+  EXPECT_EQ(outer[0].size(), std::size_t(4) << 20);
+  EXPECT_GT(my::trim_if_over_budget(), 0);
+  EXPECT_EQ(outer.capacity(), 2);
+  EXPECT_EQ(outer[0].size(), std::size_t(4) << 20);
+}
@@ -0,0 +1,306 @@
+/*
+   Ordered, double buffered file sink for whole MyVector batches
+*/
+
+#ifndef MY_VECTOR_SINK_H
+#define MY_VECTOR_SINK_H
+
+#include <cerrno>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "../MyVector/MyVector.h"
+
+namespace my {
+
+/* Formatter tag: write the elements' bytes as they are, straight out of the
+   batch, without any copy. Needs a trivially copyable T. */
+struct RawRecords {};
+
+/* Counters of a VectorSink */
+struct SinkStats {
+  std::size_t batches = 0;  // Batches written
+  std::size_t bytes = 0;    // Bytes written
+  std::size_t syscalls = 0; // writev calls made
+  std::size_t recycled = 0; // Written batches held for acquire()
+};
+
+/* Producers hand over whole MyVector batches by move and carry on; a single
+   writer thread writes them in order. Whatever has queued up while the
+   writer was busy goes out in one writev, and every written batch is
+   cleared and kept, up to 2 * max_queued of them, so acquire() can hand its
+   capacity back to a producer; any more are freed. At most max_queued
+   batches wait at a time, past that write() blocks.
+
+   Formatter is either RawRecords or a callable
+   void(const T &element, std::string &out) that appends the text of one
+   element; formatting then also happens on the writer thread. A write
+   error stops the writer and is rethrown as std::system_error from the
+   next write(), flush() or close(). */
+template <typename T, typename Formatter = RawRecords>
+class VectorSink {
+  static constexpr bool kRaw = std::is_same<Formatter, RawRecords>::value;
+  static_assert(!kRaw || std::is_trivially_copyable<T>::value,
+                "RawRecords needs a trivially copyable element type");
+
+ public:
+  using ValueType = T;
+  using BatchType = MyVector<T>;
+
+ public:
+  /* Writes to fd, which stays open; the sink never closes it */
+  explicit VectorSink(int fd, std::size_t max_queued = 4, Formatter format = Formatter())
+    : fd_(fd), owns_fd_(false), max_queued_(max_queued ? max_queued : 1), format_(std::move(format)) {
+    Start();
+  }
+
+  /* Creates or truncates the file at path */
+  explicit VectorSink(const std::string &path, std::size_t max_queued = 4, Formatter format = Formatter())
+    : fd_(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)), owns_fd_(true),
+      max_queued_(max_queued ? max_queued : 1), format_(std::move(format)) {
+    if (fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), "VectorSink could not open " + path);
+    }
+    try {
+      Start();
+    } catch (...) {
+      ::close(fd_); // The destructor does not run for a throwing constructor
+      throw;
+    }
+  }
+
+  VectorSink(const VectorSink &) = delete;
+  VectorSink &operator=(const VectorSink &) = delete;
+
+  ~VectorSink() {
+    try {
+      close();
+    } catch (...) {
+      // Destructors must not throw; call close() to see the error
+    }
+  }
+
+  /* An empty batch, recycled from an earlier write when there is one */
+  BatchType acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_.size() == 0) {
+      return BatchType();
+    }
+    BatchType batch(std::move(free_[free_.size() - 1]));
+    free_.pop_back();
+    return batch;
+  }
+
+  /* Queues batch for writing, waiting while the queue is full */
+  void write(BatchType &&batch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    space_.wait(lock, [this]() { return queue_.size() < max_queued_ || error_ || closing_; });
+    ThrowIfFailed();
+    if (closing_) {
+      throw std::logic_error("write() on a closed VectorSink");
+    }
+    queue_.push_back(std::move(batch));
+    work_.notify_one();
+  }
+
+  /* Waits until everything written so far has reached the file */
+  void flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return (queue_.size() == 0 && !writing_) || error_; });
+    ThrowIfFailed();
+  }
+
+  /* Flushes, stops the writer and closes the file if the sink opened it */
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_) {
+        return;
+      }
+      closed_ = true;
+      closing_ = true;
+    }
+    work_.notify_one();
+    space_.notify_all();
+    writer_.join();
+    if (owns_fd_) {
+      ::close(fd_);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    ThrowIfFailed();
+  }
+
+  SinkStats stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SinkStats stats = stats_;
+    stats.recycled = free_.size();
+    return stats;
+  }
+
+ private:
+  static constexpr std::size_t kMaxIovecs = IOV_MAX < 64 ? IOV_MAX : 64;
+
+  void Start() {
+    queue_.reserve(max_queued_);
+    free_.reserve(MaxRecycled());
+    writer_ = std::thread([this]() { Run(); });
+  }
+
+  /* Batches kept for acquire(). Producers that build fresh vectors instead
+     would otherwise have every buffer they ever wrote kept here. */
+  std::size_t MaxRecycled() const {
+    return 2 * max_queued_;
+  }
+
+  void ThrowIfFailed() {
+    if (error_) {
+      throw std::system_error(error_, std::generic_category(), "VectorSink write failed");
+    }
+  }
+
+  /* Writer thread: takes every queued batch at once, so batches produced
+     while it was in writev are coalesced into the next call */
+  void Run() {
+    MyVector<BatchType> taken;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_.wait(lock, [this]() { return queue_.size() > 0 || closing_; });
+        if (queue_.size() == 0) {
+          return;
+        }
+        for (std::size_t i {0}; i < queue_.size(); i++) {
+          taken.push_back(std::move(queue_[i]));
+        }
+        queue_.clear();
+        writing_ = true;
+      }
+      space_.notify_all();
+
+      int error = WriteAll(taken);
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (std::size_t i {0}; i < taken.size() && free_.size() < MaxRecycled(); i++) {
+        taken[i].clear();
+        free_.push_back(std::move(taken[i]));
+      }
+      stats_.batches += taken.size();
+      taken.clear(); // Frees the batches past MaxRecycled()
+      writing_ = false;
+      if (error != 0) {
+        error_ = error;
+        closing_ = true;
+        for (std::size_t i {0}; i < queue_.size(); i++) { // Nothing more will be written
+          queue_[i].clear();
+        }
+      }
+      idle_.notify_all();
+      space_.notify_all();
+      if (error != 0) {
+        return;
+      }
+    }
+  }
+
+  /* Writes the batches in order, kMaxIovecs buffers per call. Returns 0 or
+     an errno value. */
+  int WriteAll(MyVector<BatchType> &batches) {
+    iovec iov[kMaxIovecs];
+    std::size_t n {0};
+    for (std::size_t b {0}; b < batches.size(); b++) {
+      const BatchType &batch = batches[b];
+      if (batch.size() == 0) {
+        continue;
+      }
+      if constexpr (kRaw) {
+        iov[n].iov_base = static_cast<void*>(batch.data());
+        iov[n].iov_len = batch.size() * sizeof(T);
+      } else {
+        std::string &text = text_[n];
+        text.clear();
+        for (std::size_t i {0}; i < batch.size(); i++) {
+          format_(batch[i], text);
+        }
+        iov[n].iov_base = &text[0];
+        iov[n].iov_len = text.size();
+      }
+      if (++n == kMaxIovecs) {
+        if (int error = WriteVectors(iov, n)) {
+          return error;
+        }
+        n = 0;
+      }
+    }
+    return n > 0 ? WriteVectors(iov, n) : 0;
+  }
+
+  /* One writev for n buffers, resumed after partial writes */
+  int WriteVectors(iovec* iov, std::size_t n) {
+    std::size_t total {0};
+    for (std::size_t i {0}; i < n; i++) {
+      total += iov[i].iov_len;
+    }
+    std::size_t syscalls {0};
+    while (n > 0) {
+      ssize_t written = ::writev(fd_, iov, static_cast<int>(n));
+      syscalls++;
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return errno;
+      }
+      std::size_t left = static_cast<std::size_t>(written);
+      while (n > 0 && left >= iov->iov_len) {
+        left -= iov->iov_len;
+        iov++;
+        n--;
+      }
+      if (n > 0) {
+        iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+        iov->iov_len -= left;
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.bytes += total;
+    stats_.syscalls += syscalls;
+    return 0;
+  }
+
+  int fd_;
+  bool owns_fd_;
+  std::size_t max_queued_;
+  Formatter format_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_;   // Writer waits for batches
+  std::condition_variable space_;  // Producers wait for queue space
+  std::condition_variable idle_;   // flush() waits for the writer
+  MyVector<BatchType> queue_;      // Oldest batch first
+  MyVector<BatchType> free_;       // Written batches, cleared, for acquire()
+  bool writing_ = false;
+  bool closing_ = false; // No more writes are taken
+  bool closed_ = false;  // close() has run
+  int error_ = 0;
+  SinkStats stats_;
+
+  std::string text_[kRaw ? 1 : kMaxIovecs]; // Formatting buffer per iovec, reused
+  std::thread writer_;
+};
+
+} // Namespace bracket
+
+#endif
@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../VectorSink.h"
+
+// Producer side cost of writing batches of 4096 uint64_t to a file, either
+// synchronously on the producer thread or handed to a VectorSink. Each
+// iteration fills and writes one batch.
+
+static const char* kPath = "/tmp/vector_sink_benchmark.out";
+static constexpr std::size_t kBatch = 4096;
+
+static void FillBatch(MyVector<std::uint64_t> &batch, std::uint64_t seed) {
+  for (std::size_t i {0}; i < kBatch; i++) {
+    batch.push_back(seed * kBatch + i);
+  }
+}
+
+static void BM_SyncText(benchmark::State &state) {
+  std::ofstream out(kPath);
+  std::uint64_t seed {0};
+  for (auto _ : state) {
+    MyVector<std::uint64_t> batch;
+    FillBatch(batch, seed++);
+    out << batch << '\n';
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+static void BM_SinkText(benchmark::State &state) {
+  auto format = [](const std::uint64_t &x, std::string &out) {
+    out += std::to_string(x);
+    out += ',';
+  };
+  my::VectorSink<std::uint64_t, decltype(format)> sink(kPath, 8, format);
+  std::uint64_t seed {0};
+  for (auto _ : state) {
+    MyVector<std::uint64_t> batch = sink.acquire();
+    FillBatch(batch, seed++);
+    sink.write(std::move(batch));
+  }
+  sink.close();
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+static void BM_SyncRaw(benchmark::State &state) {
+  int fd = ::open(kPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  std::uint64_t seed {0};
+  for (auto _ : state) {
+    MyVector<std::uint64_t> batch;
+    FillBatch(batch, seed++);
+    benchmark::DoNotOptimize(::write(fd, batch.data(), batch.size() * sizeof(std::uint64_t)));
+  }
+  ::close(fd);
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+static void BM_SinkRaw(benchmark::State &state) {
+  my::VectorSink<std::uint64_t> sink(kPath, 8);
+  std::uint64_t seed {0};
+  for (auto _ : state) {
+    MyVector<std::uint64_t> batch = sink.acquire();
+    FillBatch(batch, seed++);
+    sink.write(std::move(batch));
+  }
+  sink.close();
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+BENCHMARK(BM_SyncText);
+BENCHMARK(BM_SinkText);
+BENCHMARK(BM_SyncRaw);
+BENCHMARK(BM_SinkRaw);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,124 @@
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include "../VectorSink.h"
+
+using my::VectorSink;
+
+class VectorSinkTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char name[] = "/tmp/vector_sink_XXXXXX";
+    int fd = mkstemp(name);
+    ::close(fd);
+    path_ = name;
+  }
+
+  void TearDown() override {
+    std::remove(path_.c_str());
+  }
+
+  std::string Contents() const {
+    std::ifstream in(path_, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  std::string path_;
+};
+
+TEST_F(VectorSinkTest, RawRecordsInOrder) {
+  {
+    VectorSink<std::uint32_t> sink(path_, 2);
+    for (std::uint32_t b {0}; b < 100; b++) {
+      MyVector<std::uint32_t> batch = sink.acquire();
+      for (std::uint32_t i {0}; i < 50; i++) {
+        batch.push_back(b * 50 + i);
+      }
+      sink.write(std::move(batch));
+    }
+    sink.close();
+    EXPECT_EQ(sink.stats().batches, 100);
+    EXPECT_EQ(sink.stats().bytes, 5000 * sizeof(std::uint32_t));
+    EXPECT_LE(sink.stats().syscalls, 100);
+  }
+  std::string bytes = Contents();
+  ASSERT_EQ(bytes.size(), 5000 * sizeof(std::uint32_t));
+  const std::uint32_t* values = reinterpret_cast<const std::uint32_t*>(bytes.data());
+  for (std::uint32_t i {0}; i < 5000; i++) {
+    ASSERT_EQ(values[i], i);
+  }
+}
+
+TEST_F(VectorSinkTest, FormatterRunsOnWriter) {
+  auto format = [](const int &x, std::string &out) {
+    out += std::to_string(x);
+    out += '\n';
+  };
+  VectorSink<int, decltype(format)> sink(path_, 4, format);
+  MyVector<int> batch {1, 2, 3};
+  sink.write(std::move(batch));
+  MyVector<int> more {40};
+  sink.write(std::move(more));
+  sink.flush();
+  EXPECT_EQ(Contents(), "1\n2\n3\n40\n");
+}
+
+TEST_F(VectorSinkTest, WrittenBatchesComeBackWithCapacity) {
+  VectorSink<std::uint64_t> sink(path_);
+  MyVector<std::uint64_t> batch;
+  batch.reserve(1000);
+  batch.push_back(7);
+  sink.write(std::move(batch));
+  sink.flush();
+  MyVector<std::uint64_t> reused = sink.acquire();
+  EXPECT_EQ(reused.size(), 0);
+  EXPECT_GE(reused.capacity(), 1000);
+  MyVector<std::uint64_t> fresh = sink.acquire(); // Nothing left to recycle
+  EXPECT_EQ(fresh.capacity(), 0);
+}
+
+TEST_F(VectorSinkTest, RecycledBatchesAreBounded) {
+  VectorSink<std::uint64_t> sink(path_, 2);
+  for (int i {0}; i < 100; i++) {
+    MyVector<std::uint64_t> batch; // Fresh every time, never acquire()
+    batch.reserve(1000);
+    batch.push_back(i);
+    sink.write(std::move(batch));
+    if (i % 10 == 0) {
+      sink.flush();
+      EXPECT_LE(sink.stats().recycled, 4);
+    }
+  }
+  sink.flush();
+  EXPECT_EQ(sink.stats().batches, 100);
+  EXPECT_LE(sink.stats().recycled, 4);
+  EXPECT_GE(sink.acquire().capacity(), 1000); // Still recycles up to the bound
+}
+
+TEST_F(VectorSinkTest, WriteAfterCloseThrows) {
+  VectorSink<int> sink(path_);
+  sink.close();
+  EXPECT_THROW(sink.write(MyVector<int> {1}), std::logic_error);
+}
+
+TEST(VectorSinkErrors, OpenFailureThrows) {
+  EXPECT_THROW(VectorSink<int>("/nonexistent-dir/out.bin"), std::system_error);
+}
+
+TEST(VectorSinkErrors, WriteFailureIsReported) {
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  ::close(fds[0]); // Writing to a pipe without a reader fails with EPIPE
+  signal(SIGPIPE, SIG_IGN);
+  VectorSink<int> sink(fds[1]);
+  sink.write(MyVector<int> {1, 2, 3});
+  EXPECT_THROW(sink.flush(), std::system_error);
+  ::close(fds[1]);
+}
@@ -0,0 +1,130 @@
+/*
+   Non owning view over a contiguous run of elements
+*/
+
+#ifndef MY_VECTOR_VIEW_H
+#define MY_VECTOR_VIEW_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace my {
+
+/* A pointer and a length. Converts implicitly from MyVector, any other
+   container with data() and size() (MyStaticVector, std::vector, ...) and
+   raw arrays, so slicing a vector is two words and never allocates. The
+   viewed storage must outlive the view, and growing the underlying vector
+   invalidates it exactly like it invalidates iterators. */
+template <typename T>
+class VectorView {
+ public:
+  using ValueType = T;
+  using PointerType = T*;
+  using ReferenceType = T&;
+  using Iterator = T*;
+
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+ public:
+  /* Constructors */
+
+  VectorView()
+    : data_(nullptr), size_(0) {}
+
+  VectorView(PointerType data, std::size_t size)
+    : data_(data), size_(size) {}
+
+  template <std::size_t N>
+  VectorView(T (&array)[N])
+    : data_(array), size_(N) {}
+
+  /* Any container exposing contiguous storage through data() and size() */
+  template <typename Container,
+            typename = std::enable_if_t<
+              !std::is_same<std::remove_cv_t<Container>, VectorView>::value &&
+              std::is_convertible<decltype(std::declval<Container&>().data()), PointerType>::value>>
+  VectorView(Container &c)
+    : data_(c.data()), size_(c.size()) {}
+
+  /* VectorView<T> to VectorView<const T> */
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible<U(*)[], T(*)[]>::value>>
+  VectorView(const VectorView<U> &rhs)
+    : data_(rhs.data()), size_(rhs.size()) {}
+
+  /* Element access */
+
+  ReferenceType operator[](std::size_t i) const {
+    return data_[i];
+  }
+
+  ReferenceType at(std::size_t pos) const {
+    if (pos >= size_) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    return data_[pos];
+  }
+
+  ReferenceType front() const { return data_[0]; }
+
+  ReferenceType back() const { return data_[size_ - 1]; }
+
+  PointerType data() const { return data_; }
+
+  /* Iterators */
+
+  Iterator begin() const { return data_; }
+
+  Iterator end() const { return data_ + size_; }
+
+  /* Capacity */
+
+  std::size_t size() const { return size_; }
+
+  std::size_t size_bytes() const { return size_ * sizeof(T); }
+
+  bool empty() const { return size_ == 0; }
+
+  /* Slicing */
+
+  /* count elements starting at offset, clamped to the end of the view */
+  VectorView subview(std::size_t offset, std::size_t count = npos) const {
+    if (offset > size_) {
+      throw std::out_of_range("Offset larger than this->size()");
+    }
+    std::size_t rest = size_ - offset;
+    return VectorView(data_ + offset, count < rest ? count : rest);
+  }
+
+  VectorView first(std::size_t count) const {
+    if (count > size_) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    return VectorView(data_, count);
+  }
+
+  VectorView last(std::size_t count) const {
+    if (count > size_) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    return VectorView(data_ + size_ - count, count);
+  }
+
+  /* Splits into [0, pos) and [pos, size()) */
+  std::pair<VectorView, VectorView> split_at(std::size_t pos) const {
+    if (pos > size_) {
+      throw std::out_of_range("Larger than this->size()");
+    }
+    return {VectorView(data_, pos), VectorView(data_ + pos, size_ - pos)};
+  }
+
+ private:
+  PointerType data_;
+  std::size_t size_;
+};
+
+} // Namespace bracket
+
+#endif
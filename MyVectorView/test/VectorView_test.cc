@@ -0,0 +1,88 @@
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../VectorView.h"
+#include "../../MyVector/MyVector.h"
+#include "../../MyStaticVector/MyStaticVector.h"
+
+using my::VectorView;
+
+static_assert(sizeof(VectorView<int>) == 2 * sizeof(void*), "A view should be two words");
+static_assert(std::is_trivially_copyable<VectorView<int>>::value, "A view should copy like a pair of words");
+
+// Stand in for an algorithm taking a view parameter
+static int Sum(VectorView<const int> v) {
+  return std::accumulate(v.begin(), v.end(), 0);
+}
+
+TEST(VectorViewConversions, FromMyVector) {
+  MyVector<int> mv {1, 2, 3, 4};
+  VectorView<int> view = mv;
+  EXPECT_EQ(view.size(), 4);
+  EXPECT_EQ(view.data(), mv.data());
+  EXPECT_EQ(Sum(mv), 10);
+}
+
+TEST(VectorViewConversions, FromStaticVectorAndArray) {
+  MyStaticVector<int, 8> sv {1, 2, 3};
+  int array[] {4, 5, 6};
+  std::vector<int> v {7, 8};
+  EXPECT_EQ(Sum(sv), 6);
+  EXPECT_EQ(Sum(array), 15);
+  EXPECT_EQ(Sum(v), 15);
+}
+
+TEST(VectorViewConversions, MutableToConst) {
+  MyVector<int> mv {1, 2};
+  VectorView<int> view = mv;
+  VectorView<const int> const_view = view;
+  view[0] = 5;
+  EXPECT_EQ(const_view[0], 5);
+  EXPECT_EQ(mv[0], 5);
+}
+
+struct VectorViewTest : testing::Test {
+  MyVector<int> mv {0, 1, 2, 3, 4, 5, 6, 7};
+  VectorView<int> view = mv;
+};
+
+TEST_F(VectorViewTest, AtMethodOutOfRange) {
+  EXPECT_EQ(view.at(7), 7);
+  EXPECT_THROW(view.at(8), std::out_of_range);
+}
+
+TEST_F(VectorViewTest, Subview) {
+  auto sub = view.subview(2, 3);
+  ASSERT_EQ(sub.size(), 3);
+  EXPECT_EQ(sub.front(), 2);
+  EXPECT_EQ(sub.back(), 4);
+  EXPECT_EQ(view.subview(6).size(), 2);
+  EXPECT_EQ(view.subview(8).size(), 0);
+  EXPECT_THROW(view.subview(9), std::out_of_range);
+}
+
+TEST_F(VectorViewTest, FirstAndLast) {
+  EXPECT_EQ(Sum(view.first(3)), 3);
+  EXPECT_EQ(Sum(view.last(2)), 13);
+  EXPECT_THROW(view.first(9), std::out_of_range);
+  EXPECT_THROW(view.last(9), std::out_of_range);
+}
+
+TEST_F(VectorViewTest, SplitAt) {
+  auto halves = view.split_at(5);
+  EXPECT_EQ(halves.first.size(), 5);
+  EXPECT_EQ(halves.second.size(), 3);
+  EXPECT_EQ(halves.second[0], 5);
+  EXPECT_EQ(Sum(halves.first) + Sum(halves.second), Sum(view));
+}
+
+TEST_F(VectorViewTest, Iteration) {
+  for (int &x : view.subview(4)) {
+    x *= 10;
+  }
+  EXPECT_EQ(mv[3], 3);
+  EXPECT_EQ(mv[4], 40);
+  EXPECT_EQ(mv[7], 70);
+}